@@ -0,0 +1,179 @@
+#include "Batch.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMap>
+#include <QTextStream>
+
+#include "FieldEngine.h"
+#include "Maze.h"
+#include "MazeCorpus.h"
+#include "MazeHash.h"
+#include "OrientedMaze.h"
+
+namespace mms {
+
+// Unreachable centers are reported as "inf", like the overlays
+static QString getText(double value) {
+    if (value < 0) {
+        return "inf";
+    }
+    return QString::number(value);
+}
+
+int Batch::run(const QStringList& arguments) {
+
+    // Evaluate every orientation of every maze, if requested
+    QStringList paths = arguments;
+    QVector<Symmetry> orientations = {Symmetry::IDENTITY};
+    if (!paths.isEmpty() && paths.first() == "--orientations") {
+        paths.removeFirst();
+        orientations = SYMMETRIES();
+    }
+
+    QTextStream out(stdout);
+    out << "maze";
+    if (1 < orientations.size()) {
+        out << "\torientation";
+    }
+    out << "\twidth\theight\tshortest path\toptimal score" << endl;
+
+    // Rotated and mirrored copies of a maze that keep the start in place
+    // have the same results, so they're only computed once
+    QMap<quint64, QString> results;
+
+    int exitCode = 0;
+    for (const QString& path : paths) {
+
+        // The index of a corpus already holds the results, unless they're
+        // needed for every orientation
+        MazeCorpus* corpus = MazeCorpus::open(path);
+        if (corpus != nullptr) {
+            for (int i = 0; i < corpus->getCount(); i += 1) {
+                MazeCorpus::Entry entry = corpus->getEntry(i);
+                QString reference =
+                    MazeCorpus::getReference(path, entry.name);
+                if (1 < orientations.size()) {
+                    Maze* maze = corpus->getMaze(i);
+                    if (maze == nullptr) {
+                        out << reference << "\tinvalid" << endl;
+                        exitCode = 1;
+                        continue;
+                    }
+                    evaluate(&out, reference, maze, orientations, &results);
+                    delete maze;
+                    continue;
+                }
+                out << reference
+                    << "\t" << entry.width
+                    << "\t" << entry.height
+                    << "\t" << getText(entry.shortestPath)
+                    << "\t" << getText(entry.optimalScore)
+                    << endl;
+            }
+            delete corpus;
+            continue;
+        }
+
+        Maze* maze = Maze::fromFile(path);
+        if (maze == nullptr) {
+            maze = MazeCorpus::fromReference(path);
+        }
+        if (maze == nullptr) {
+            out << path << "\tinvalid" << endl;
+            exitCode = 1;
+            continue;
+        }
+        evaluate(&out, path, maze, orientations, &results);
+        delete maze;
+    }
+    return exitCode;
+}
+
+int Batch::pack(const QStringList& paths) {
+
+    QTextStream out(stdout);
+    if (paths.isEmpty()) {
+        out << "usage: mms --pack <corpus> <maze files or directories>"
+            << endl;
+        return 1;
+    }
+
+    // Mazes are named by their path relative to the directory they were
+    // found in, or by their file name if they were listed directly. Rotated
+    // and mirrored copies of a maze are only packed once.
+    int exitCode = 0;
+    QMap<QString, WallGrid> mazes;
+    QMap<quint64, QString> names;
+    for (const QString& path : paths.mid(1)) {
+        QMap<QString, QString> files;
+        if (QFileInfo(path).isDir()) {
+            for (const QString& file : MazeCorpus::findMazeFiles(path)) {
+                files.insert(QDir(path).relativeFilePath(file), file);
+            }
+        }
+        else {
+            files.insert(QFileInfo(path).fileName(), path);
+        }
+        for (auto it = files.constBegin(); it != files.constEnd(); ++it) {
+            if (mazes.contains(it.key())) {
+                out << it.value() << "\tduplicate name" << endl;
+                exitCode = 1;
+                continue;
+            }
+            Maze* maze = Maze::fromFile(it.value());
+            if (maze == nullptr) {
+                out << it.value() << "\tinvalid" << endl;
+                exitCode = 1;
+                continue;
+            }
+            quint64 hash = MazeHash::getCanonicalHash(maze->getWalls());
+            if (names.contains(hash)) {
+                out << it.value() << "\tduplicate of " << names.value(hash)
+                    << endl;
+                delete maze;
+                continue;
+            }
+            names.insert(hash, it.key());
+            mazes.insert(it.key(), maze->getWalls());
+            delete maze;
+        }
+    }
+
+    if (!MazeCorpus::write(paths.first(), mazes)) {
+        out << paths.first() << "\tfailed to write" << endl;
+        return 1;
+    }
+    out << "Packed " << mazes.size() << " mazes into " << paths.first()
+        << endl;
+    return exitCode;
+}
+
+void Batch::evaluate(
+        QTextStream* out,
+        const QString& name,
+        const Maze* maze,
+        const QVector<Symmetry>& orientations,
+        QMap<quint64, QString>* results) {
+    for (Symmetry orientation : orientations) {
+        quint64 hash = MazeHash::getStartHash(maze->getWalls(), orientation);
+        if (!results->contains(hash)) {
+            FieldEngine fieldEngine(maze, orientation);
+            results->insert(
+                hash,
+                fieldEngine.getText(Field::DISTANCE_TO_CENTER, 0, 0) + "\t" +
+                getText(fieldEngine.getOptimalScore()));
+        }
+        OrientedMaze view(maze, orientation);
+        *out << name;
+        if (1 < orientations.size()) {
+            *out << "\t" << SYMMETRY_TO_STRING().value(orientation);
+        }
+        *out << "\t" << view.getWidth()
+             << "\t" << view.getHeight()
+             << "\t" << results->value(hash)
+             << endl;
+    }
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QVector>
+#include <QtGlobal>
+
+#include "Maze.h"
+#include "Symmetry.h"
+
+namespace mms {
+
+// Evaluates maze files without the GUI, printing one tab separated line of
+// results per maze to stdout; run as "mms --batch <maze files>", or as
+// "mms --batch --orientations <maze files>" for a line per orientation of
+// each maze. Corpus files (see MazeCorpus) are listed straight from their
+// index.
+class Batch {
+
+public:
+    Batch() = delete;
+
+    // Returns the process exit code, nonzero if any maze was invalid
+    static int run(const QStringList& arguments);
+
+    // Packs maze files, and every maze file under any directories, into a
+    // corpus at the first path; run as "mms --pack <corpus> <paths>"
+    static int pack(const QStringList& paths);
+
+private:
+
+    // Prints a line per orientation, reusing results by start hash
+    static void evaluate(
+        QTextStream* out,
+        const QString& name,
+        const Maze* maze,
+        const QVector<Symmetry>& orientations,
+        QMap<quint64, QString>* results);
+
+};
+
+}
@@ -1,5 +1,6 @@
 #include "BufferInterface.h"
 
+#include "AssertMacros.h"
 #include "RGB.h"
 #include "SimUtilities.h"
 
@@ -14,6 +15,15 @@ BufferInterface::BufferInterface(
         m_textureCpuBuffer(textureCpuBuffer) {
 }
 
+BufferInterface::BufferInterface(
+        const BufferInterface& other,
+        QVector<TriangleGraphic>* graphicCpuBuffer,
+        QVector<TriangleTexture>* textureCpuBuffer) :
+        BufferInterface(other) {
+    m_graphicCpuBuffer = graphicCpuBuffer;
+    m_textureCpuBuffer = textureCpuBuffer;
+}
+
 void BufferInterface::initTileGraphicText(
         const Distance& wallLength,
         const Distance& wallWidth,
@@ -30,14 +40,14 @@ QPair<int, int> BufferInterface::getTileGraphicTextMaxSize() {
     return m_tileGraphicTextCache.getTileGraphicTextMaxSize();
 }
 
-void BufferInterface::insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, unsigned char alpha) {
-    QVector<TriangleGraphic> tgs = SimUtilities::polygonToTriangleGraphics(polygon, color, alpha);
-    for (int i = 0; i < tgs.size(); i += 1) {
-        m_graphicCpuBuffer->append(tgs.at(i));
-    }
+void BufferInterface::initGraphicCpuBuffer() {
+    // Every triangle is overwritten once its tile is drawn
+    m_graphicCpuBuffer->clear();
+    m_graphicCpuBuffer->resize(
+        trianglesPerTile() * m_mazeSize.first * m_mazeSize.second);
 }
 
-void BufferInterface::insertIntoTextureCpuBuffer() {
+void BufferInterface::initTextureCpuBuffer() {
     // Here we just insert dummy TriangleTexture objects. All of the actual
     // values of the objects will be set on calls to the update method.
     // However, we do intentionally insert the appropriate 'v' values, since
@@ -53,8 +63,27 @@ void BufferInterface::insertIntoTextureCpuBuffer() {
         {0.0, 0.0, 0.0, 1.0},
         {0.0, 0.0, 0.0, 0.0},
     };
-    m_textureCpuBuffer->append(t1);
-    m_textureCpuBuffer->append(t2);
+    QPair<int, int> maxRowsAndCols = getTileGraphicTextMaxSize();
+    int count =
+        maxRowsAndCols.first * maxRowsAndCols.second *
+        m_mazeSize.first * m_mazeSize.second;
+    m_textureCpuBuffer->clear();
+    m_textureCpuBuffer->reserve(2 * count);
+    for (int i = 0; i < count; i += 1) {
+        m_textureCpuBuffer->append(t1);
+        m_textureCpuBuffer->append(t2);
+    }
+}
+
+void BufferInterface::setTileGraphicPolygon(int x, int y, int index, const Polygon& polygon, Color color, unsigned char alpha) {
+    const QVector<Triangle> triangles = polygon.getTriangles();
+    ASSERT_EQ(triangles.size(), 2);
+    int start = getTileGraphicBaseStartingIndex(x, y) + 2 * index;
+    for (int i = 0; i < 2; i += 1) {
+        (*m_graphicCpuBuffer)[start + i] =
+            SimUtilities::triangleToTriangleGraphic(
+                triangles.at(i), color, alpha);
+    }
 }
 
 void BufferInterface::updateTileGraphicBaseColor(int x, int y, Color color) {
@@ -92,7 +121,7 @@ void BufferInterface::updateTileGraphicText(int x, int y, int numRows, int numCo
     //    | /         |    | /       /         |
     //   [LL]---------+   [p1]     [p1]------[p3]
 
-    QPair<double, double> fontImageCharacterPosition =
+    const QPair<double, double>& fontImageCharacterPosition =
         m_tileGraphicTextCache.getFontImageCharacterPosition(c);
 
     QPair<Coordinate, Coordinate> LL_UR =
@@ -22,6 +22,13 @@ public:
         QVector<TriangleGraphic>* graphicCpuBuffer,
         QVector<TriangleTexture>* textureCpuBuffer);
 
+    // A copy of another interface, including its text cache, that fills the
+    // given buffers instead
+    BufferInterface(
+        const BufferInterface& other,
+        QVector<TriangleGraphic>* graphicCpuBuffer,
+        QVector<TriangleTexture>* textureCpuBuffer);
+
     // Initializes and caches all possible tile text positions. We need this
     // extra initialization function since the max size is from the algorithm.
     void initTileGraphicText(
@@ -32,9 +39,14 @@ public:
     // Returns the maximum number of rows and columns of text in a tile graphic
     QPair<int, int> getTileGraphicTextMaxSize();
 
-    // Fills the graphic cpu buffer and texture cpu buffer
-    void insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, unsigned char alpha);
-    void insertIntoTextureCpuBuffer();
+    // Sizes the graphic cpu buffer and texture cpu buffer for every tile, so
+    // that tiles can then be drawn in any order, or on many threads at once
+    void initGraphicCpuBuffer();
+    void initTextureCpuBuffer();
+
+    // Fills in one of the polygons of a tile, which must be a rectangle; the
+    // index is the order in which the polygons are drawn (see TileGraphic)
+    void setTileGraphicPolygon(int x, int y, int index, const Polygon& polygon, Color color, unsigned char alpha);
 
     // These methods are inexpensive, and may be called many times
     void updateTileGraphicBaseColor(int x, int y, Color color);
@@ -1,8 +1,10 @@
 #include "Driver.h"
 
 #include <QApplication>
+#include <QCoreApplication>
 
 #include "AssertMacros.h"
+#include "Batch.h"
 #include "ColorManager.h"
 #include "Logging.h"
 #include "Settings.h"
@@ -15,6 +17,18 @@ int Driver::drive(int argc, char* argv[]) {
     // Make sure that this function is called just once
     ASSERT_RUNS_JUST_ONCE();
 
+    // Evaluate maze files without the GUI, if requested
+    if (1 < argc && QString(argv[1]) == "--batch") {
+        QCoreApplication app(argc, argv);
+        return Batch::run(app.arguments().mid(2));
+    }
+
+    // Pack maze files into a corpus, if requested
+    if (1 < argc && QString(argv[1]) == "--pack") {
+        QCoreApplication app(argc, argv);
+        return Batch::pack(app.arguments().mid(2));
+    }
+
     // Initialize Qt
     QApplication app(argc, argv);
 
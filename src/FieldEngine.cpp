@@ -0,0 +1,200 @@
+#include "FieldEngine.h"
+
+#include "AssertMacros.h"
+
+namespace mms {
+
+const QVector<Field>& FIELDS() {
+    static const QVector<Field> vector = {
+        Field::DISTANCE_TO_CENTER,
+        Field::DISTANCE_FROM_START,
+        Field::COST_FROM_START,
+    };
+    return vector;
+}
+
+const QMap<Field, QString>& FIELD_TO_STRING() {
+    static const QMap<Field, QString> map = {
+        {Field::DISTANCE_TO_CENTER, "Distance to center"},
+        {Field::DISTANCE_FROM_START, "Distance from start"},
+        {Field::COST_FROM_START, "Cost from start"},
+    };
+    return map;
+}
+
+const int FieldEngine::COST_PER_TURN = 2;
+const int FieldEngine::COST_PER_CELL = 2;
+const int FieldEngine::COST_PER_FAST_CELL = 1;
+
+FieldEngine::FieldEngine(const Maze* maze, Symmetry symmetry) :
+    m_maze(maze, symmetry),
+    m_floodFill(maze->getWalls()) {
+}
+
+const QVector<int>& FieldEngine::getField(Field field) {
+    if (!m_fields.contains(field)) {
+        m_fields.insert(field, computeField(field));
+    }
+    return m_fields[field];
+}
+
+int FieldEngine::getValue(Field field, int x, int y) {
+    ASSERT_LE(0, x);
+    ASSERT_LE(0, y);
+    ASSERT_LT(x, m_maze.getWidth());
+    ASSERT_LT(y, m_maze.getHeight());
+    return getField(field).at(x * m_maze.getHeight() + y);
+}
+
+QString FieldEngine::getText(Field field, int x, int y) {
+    int value = getValue(field, x, y);
+    if (value < 0) {
+        return "inf";
+    }
+    if (field == Field::COST_FROM_START) {
+        return QString::number(value / 2.0);
+    }
+    return QString::number(value);
+}
+
+float FieldEngine::getOptimalScore() {
+    int optimal = -1;
+    QVector<QPair<int, int>> centers = Maze::getCenterPositions(
+        m_maze.getWidth(), m_maze.getHeight());
+    for (QPair<int, int> center : centers) {
+        int x = center.first;
+        int y = center.second;
+        int cost = getValue(Field::COST_FROM_START, x, y);
+        if (cost != -1 && (optimal == -1 || cost < optimal)) {
+            optimal = cost;
+        }
+    }
+    return optimal == -1 ? -1 : optimal / 2.0;
+}
+
+QVector<int> FieldEngine::computeField(Field field) const {
+    switch (field) {
+        case Field::DISTANCE_TO_CENTER: {
+            QVector<int> distances;
+            distances.reserve(m_maze.getWidth() * m_maze.getHeight());
+            for (int x = 0; x < m_maze.getWidth(); x += 1) {
+                for (int y = 0; y < m_maze.getHeight(); y += 1) {
+                    distances.append(m_maze.getDistance(x, y));
+                }
+            }
+            return distances;
+        }
+        case Field::DISTANCE_FROM_START: {
+
+            // The flood fill works on the maze itself, so reorder its cells
+            const Maze* maze = m_maze.getMaze();
+            QVector<int> distances =
+                m_floodFill.getDistances({m_maze.toMaze(0, 0)});
+            if (m_maze.getSymmetry() == Symmetry::IDENTITY) {
+                return distances;
+            }
+            QVector<int> field;
+            field.reserve(distances.size());
+            for (int x = 0; x < m_maze.getWidth(); x += 1) {
+                for (int y = 0; y < m_maze.getHeight(); y += 1) {
+                    QPair<int, int> position = m_maze.toMaze(x, y);
+                    field.append(distances.at(
+                        position.first * maze->getHeight() + position.second));
+                }
+            }
+            return field;
+        }
+        case Field::COST_FROM_START:
+            return getCostsFromStart();
+    }
+    ASSERT_NEVER_RUNS();
+}
+
+QVector<int> FieldEngine::getCostsFromStart() const {
+
+    // Headings are numbered like DIRECTIONS(), so turning right is +1
+    static const int DX[] = {0, 1, 0, -1};
+    static const int DY[] = {1, 0, -1, 0};
+    static const int HEADINGS = 4;
+    static const int RUNS = 3;
+
+    int width = m_maze.getWidth();
+    int height = m_maze.getHeight();
+    auto getState = [&](int x, int y, int heading, int run) {
+        return ((x * height + y) * HEADINGS + heading) * RUNS + run;
+    };
+
+    // Every edge costs at most COST_PER_TURN, so a ring of that many plus
+    // one buckets holds every tentative cost that's still pending
+    QVector<int> costs(width * height * HEADINGS * RUNS, -1);
+    QVector<QVector<int>> buckets(COST_PER_TURN + 1);
+    int pending = 0;
+    auto relax = [&](int state, int cost) {
+        if (costs.at(state) == -1 || cost < costs.at(state)) {
+            costs[state] = cost;
+            buckets[cost % buckets.size()].append(state);
+            pending += 1;
+        }
+    };
+
+    // Turning in the start cell is free, since Stats only starts counting
+    // once the mouse leaves it
+    for (int heading = 0; heading < HEADINGS; heading += 1) {
+        relax(getState(0, 0, heading, 0), 0);
+    }
+
+    for (int cost = 0; 0 < pending; cost += 1) {
+        QVector<int> bucket;
+        bucket.swap(buckets[cost % buckets.size()]);
+        pending -= bucket.size();
+        for (int state : bucket) {
+
+            // Skip stale entries, the state was reached more cheaply
+            if (costs.at(state) != cost) {
+                continue;
+            }
+            int run = state % RUNS;
+            int heading = (state / RUNS) % HEADINGS;
+            int cell = state / (RUNS * HEADINGS);
+            int x = cell / height;
+            int y = cell % height;
+
+            // Continue the current straight
+            if (!m_maze.isWall(x, y, DIRECTIONS().at(heading))) {
+                int step = run < 2 ? COST_PER_CELL : COST_PER_FAST_CELL;
+                relax(
+                    getState(
+                        x + DX[heading],
+                        y + DY[heading],
+                        heading,
+                        qMin(run + 1, RUNS - 1)),
+                    cost + step);
+            }
+
+            // Turn, which ends the straight
+            relax(
+                getState(x, y, (heading + 1) % HEADINGS, 0),
+                cost + COST_PER_TURN);
+            relax(
+                getState(x, y, (heading + HEADINGS - 1) % HEADINGS, 0),
+                cost + COST_PER_TURN);
+        }
+    }
+
+    // The cost of a cell is the cost of its cheapest state
+    QVector<int> field(width * height, -1);
+    for (int cell = 0; cell < width * height; cell += 1) {
+        for (int i = 0; i < HEADINGS * RUNS; i += 1) {
+            int cost = costs.at(cell * HEADINGS * RUNS + i);
+            if (cost == -1) {
+                continue;
+            }
+            if (field.at(cell) == -1 || cost < field.at(cell)) {
+                field[cell] = cost;
+            }
+        }
+    }
+    return field;
+}
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include "FloodFill.h"
+#include "Maze.h"
+#include "OrientedMaze.h"
+#include "Symmetry.h"
+
+namespace mms {
+
+enum class Field {
+    DISTANCE_TO_CENTER,
+    DISTANCE_FROM_START,
+    COST_FROM_START,
+};
+
+// A convenient way to enumerate through all of the fields
+const QVector<Field>& FIELDS();
+
+const QMap<Field, QString>& FIELD_TO_STRING();
+
+// Computes per-cell values over a maze, such as the distance to the center
+// or the cheapest way to get somewhere as scored by Stats. Each field is
+// computed the first time it's requested and then cached, so there should
+// be one engine per maze. The maze can also be evaluated as if it were
+// rotated or mirrored, in which case positions are in the rotated or
+// mirrored coordinates and runs start from its (0, 0).
+class FieldEngine {
+
+public:
+
+    explicit FieldEngine(
+        const Maze* maze, Symmetry symmetry = Symmetry::IDENTITY);
+
+    // The values of a field, indexed by x * height + y; unreachable cells
+    // are -1. Costs are in half units, see COST_PER_TURN and friends.
+    const QVector<int>& getField(Field field);
+    int getValue(Field field, int x, int y);
+
+    // The value as it should be displayed, e.g., "inf" for unreachable cells
+    QString getText(Field field, int x, int y);
+
+    // The lowest turns plus effective distance of a run from the start to
+    // the center, i.e., the best run score that an algorithm could possibly
+    // achieve; -1 if the center can't be reached
+    float getOptimalScore();
+
+    // Stats charges 1 per turn and getEffectiveDistance() per straight,
+    // i.e., 1 per cell for the first two cells and 1/2 per cell after that.
+    // Doubling those keeps every cost an integer.
+    static const int COST_PER_TURN;
+    static const int COST_PER_CELL;
+    static const int COST_PER_FAST_CELL;
+
+private:
+
+    OrientedMaze m_maze;
+    FloodFill m_floodFill;
+    QMap<Field, QVector<int>> m_fields;
+
+    QVector<int> computeField(Field field) const;
+
+    // A bucketed Dijkstra over (cell, heading, cells into the current
+    // straight) states, where the straight length saturates at two
+    QVector<int> getCostsFromStart() const;
+};
+
+}
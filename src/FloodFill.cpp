@@ -0,0 +1,472 @@
+#include "FloodFill.h"
+
+#include <QtAlgorithms>
+
+#include "AssertMacros.h"
+
+// The AVX2 kernel is compiled for that instruction set on its own and only
+// called if the CPU supports it, so the rest of the build is unaffected
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MMS_FLOOD_FILL_AVX2
+#include <immintrin.h>
+#endif
+
+namespace mms {
+
+const int FloodFill::WORDS_PER_BLOCK = 4;
+const int FloodFill::CELLS_PER_BLOCK = 64 * FloodFill::WORDS_PER_BLOCK;
+const int FloodFill::MIN_BIT_CELLS = 64 * 64;
+const int FloodFill::MAX_BIT_SIDE = 256;
+const double FloodFill::MIN_LOOPS_PER_CELL = 0.08;
+
+// Expands the four words of one block. The words of the rows below and
+// above are already masked by their open north and south walls, eastCarry
+// is the cell moving east into bit 0 from the block to the west, and
+// westCarry is the cell moving west into bit 63 from the block to the east.
+static bool expandWordsScalar(
+        const quint64* frontier,
+        const quint64* openEast,
+        const quint64* openWest,
+        const quint64* fromBelow,
+        const quint64* fromAbove,
+        quint64 eastCarry,
+        quint64 westCarry,
+        quint64* next,
+        quint64* visited) {
+    quint64 east[4];
+    quint64 west[4];
+    for (int i = 0; i < 4; i += 1) {
+        east[i] = frontier[i] & openEast[i];
+        west[i] = frontier[i] & openWest[i];
+    }
+    quint64 any = 0;
+    for (int i = 0; i < 4; i += 1) {
+        quint64 eastOut = i == 0 ? eastCarry : east[i - 1] >> 63;
+        quint64 westOut = i == 3 ? westCarry : west[i + 1] << 63;
+        quint64 inEast = (east[i] << 1) | eastOut;
+        quint64 inWest = (west[i] >> 1) | westOut;
+        quint64 reached = inEast | inWest | fromBelow[i] | fromAbove[i];
+        next[i] = reached & ~visited[i];
+        visited[i] |= next[i];
+        any |= next[i];
+    }
+    return any != 0;
+}
+
+#ifdef MMS_FLOOD_FILL_AVX2
+__attribute__((target("avx2")))
+static bool expandWordsAvx2(
+        const quint64* frontier,
+        const quint64* openEast,
+        const quint64* openWest,
+        const quint64* fromBelow,
+        const quint64* fromAbove,
+        quint64 eastCarry,
+        quint64 westCarry,
+        quint64* next,
+        quint64* visited) {
+
+    __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(frontier));
+    __m256i east = _mm256_and_si256(f,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(openEast)));
+    __m256i west = _mm256_and_si256(f,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(openWest)));
+
+    // Shifting across the 64-bit lanes takes the bit that falls off of each
+    // lane, rotates it into the neighboring lane, and fills the end with the
+    // carry from the neighboring block
+    __m256i eastOut = _mm256_permute4x64_epi64(
+        _mm256_srli_epi64(east, 63), _MM_SHUFFLE(2, 1, 0, 3));
+    eastOut = _mm256_blend_epi32(eastOut,
+        _mm256_set_epi64x(0, 0, 0, static_cast<qint64>(eastCarry)), 0x03);
+    __m256i inEast = _mm256_or_si256(_mm256_slli_epi64(east, 1), eastOut);
+
+    __m256i westOut = _mm256_permute4x64_epi64(
+        _mm256_slli_epi64(west, 63), _MM_SHUFFLE(0, 3, 2, 1));
+    westOut = _mm256_blend_epi32(westOut,
+        _mm256_set_epi64x(static_cast<qint64>(westCarry), 0, 0, 0), 0xC0);
+    __m256i inWest = _mm256_or_si256(_mm256_srli_epi64(west, 1), westOut);
+
+    __m256i reached = _mm256_or_si256(
+        _mm256_or_si256(inEast, inWest),
+        _mm256_or_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fromBelow)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(fromAbove))));
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visited));
+    __m256i n = _mm256_andnot_si256(v, reached);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(next), n);
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(visited), _mm256_or_si256(v, n));
+    return !_mm256_testz_si256(n, n);
+}
+#endif
+
+// Reads count bits, at most 64, from a bit plane, starting at bit start
+static quint64 readBits(const quint64* plane, qint64 start, int count) {
+    qint64 word = start / 64;
+    int shift = start % 64;
+    quint64 bits = plane[word] >> shift;
+    if (0 < shift && 64 < shift + count) {
+        bits |= plane[word + 1] << (64 - shift);
+    }
+    return bits;
+}
+
+// A mask of the low count bits, for count between 1 and 64
+static quint64 getLowBits(int count) {
+    return count == 64 ? ~quint64(0) : (quint64(1) << count) - 1;
+}
+
+FloodFill::FloodFill(const WallGrid& walls) :
+    FloodFill(walls, getBestMethod(walls)) {
+}
+
+FloodFill::FloodFill(const WallGrid& walls, FloodFillMethod method) :
+    m_width(walls.getWidth()),
+    m_height(walls.getHeight()),
+    m_blocksPerRow((walls.getWidth() + CELLS_PER_BLOCK - 1) / CELLS_PER_BLOCK),
+    m_method(method) {
+
+    if (m_method == FloodFillMethod::BIT_PARALLEL_AVX2) {
+        ASSERT_TR(isAvx2Supported());
+    }
+    if (m_method == FloodFillMethod::QUEUE) {
+        m_walls = walls;
+        return;
+    }
+
+    int words = m_height * m_blocksPerRow * WORDS_PER_BLOCK;
+    m_openNorth.fill(0, words);
+    m_openEast.fill(0, words);
+    m_openSouth.fill(0, words);
+    m_openWest.fill(0, words);
+
+    // The masks are read a word at a time from the wall planes. Moves off
+    // the edge of the grid are never allowed, even if the maze isn't
+    // enclosed, so that bits can't wrap into other rows or blocks.
+    const quint64* horizontal = walls.getHorizontalWalls().constData();
+    const quint64* vertical = walls.getVerticalWalls().constData();
+    int rowWords = m_blocksPerRow * WORDS_PER_BLOCK;
+    for (int y = 0; y < m_height; y += 1) {
+        for (int x = 0; x < m_width; x += 64) {
+            int count = qMin(64, m_width - x);
+            int index = y * rowWords + x / 64;
+            if (0 < y) {
+                m_openSouth[index] =
+                    ~readBits(horizontal, qint64(y) * m_width + x, count) &
+                    getLowBits(count);
+            }
+            if (y < m_height - 1) {
+                m_openNorth[index] =
+                    ~readBits(horizontal, qint64(y + 1) * m_width + x, count) &
+                    getLowBits(count);
+            }
+        }
+    }
+
+    // Column x of the vertical plane is the western edge of the cells in
+    // column x, and so the eastern edge of those in column x - 1
+    for (int x = 1; x < m_width; x += 1) {
+        for (int y = 0; y < m_height; y += 64) {
+            int count = qMin(64, m_height - y);
+            quint64 open =
+                ~readBits(vertical, qint64(x) * m_height + y, count) &
+                getLowBits(count);
+            while (open != 0) {
+                int row = y + qCountTrailingZeroBits(open);
+                m_openWest[getWordIndex(x, row)] |= quint64(1) << (x % 64);
+                m_openEast[getWordIndex(x - 1, row)] |=
+                    quint64(1) << ((x - 1) % 64);
+                open &= open - 1;
+            }
+        }
+    }
+}
+
+int FloodFill::getWidth() const {
+    return m_width;
+}
+
+int FloodFill::getHeight() const {
+    return m_height;
+}
+
+FloodFillMethod FloodFill::getMethod() const {
+    return m_method;
+}
+
+QVector<int> FloodFill::getDistances(
+        const QVector<QPair<int, int>>& sources) const {
+    for (QPair<int, int> source : sources) {
+        ASSERT_LE(0, source.first);
+        ASSERT_LE(0, source.second);
+        ASSERT_LT(source.first, m_width);
+        ASSERT_LT(source.second, m_height);
+    }
+    if (m_method == FloodFillMethod::QUEUE) {
+        return getDistancesByQueue(sources);
+    }
+    return getDistancesByBits(sources);
+}
+
+FloodFillMethod FloodFill::getBestMethod(const WallGrid& walls) {
+
+    int width = walls.getWidth();
+    int height = walls.getHeight();
+    if (qint64(width) * height < MIN_BIT_CELLS ||
+            MAX_BIT_SIDE < width || MAX_BIT_SIDE < height) {
+        return FloodFillMethod::QUEUE;
+    }
+
+    // A perfect maze has cells - 1 passages between cells, and every passage
+    // beyond that closes a loop. The walls are counted straight from the bit
+    // planes; walls around the edge of an enclosed maze cancel out of
+    // edges - numWalls, so the estimate is only off for a maze that isn't
+    // enclosed, which can only cost speed.
+    qint64 numWalls = 0;
+    for (quint64 word : walls.getHorizontalWalls()) {
+        numWalls += qPopulationCount(word);
+    }
+    for (quint64 word : walls.getVerticalWalls()) {
+        numWalls += qPopulationCount(word);
+    }
+    qint64 cells = qint64(width) * height;
+    qint64 edges = 2 * cells + width + height;
+    qint64 loops = (edges - numWalls) - (cells - 1);
+    if (loops < MIN_LOOPS_PER_CELL * cells) {
+        return FloodFillMethod::QUEUE;
+    }
+    if (isAvx2Supported()) {
+        return FloodFillMethod::BIT_PARALLEL_AVX2;
+    }
+    return FloodFillMethod::BIT_PARALLEL;
+}
+
+QVector<int> FloodFill::getDistancesByQueue(
+        const QVector<QPair<int, int>>& sources) const {
+
+    // Cells are numbered x * height + y, so the neighbors to the north and
+    // south are one apart, and those to the east and west are height apart
+    QVector<int> distances(m_width * m_height, -1);
+    QVector<int> queue(m_width * m_height);
+    int* distanceData = distances.data();
+    int* queueData = queue.data();
+    int head = 0;
+    int tail = 0;
+    for (QPair<int, int> source : sources) {
+        int index = source.first * m_height + source.second;
+        if (distanceData[index] == -1) {
+            distanceData[index] = 0;
+            queueData[tail] = index;
+            tail += 1;
+        }
+    }
+
+    while (head < tail) {
+        int index = queueData[head];
+        head += 1;
+        int x = index / m_height;
+        int y = index % m_height;
+        int next = distanceData[index] + 1;
+        int neighbors[4] = {
+            y < m_height - 1 && !m_walls.isWall(x, y, Direction::NORTH)
+                ? index + 1 : -1,
+            x < m_width - 1 && !m_walls.isWall(x, y, Direction::EAST)
+                ? index + m_height : -1,
+            0 < y && !m_walls.isWall(x, y, Direction::SOUTH)
+                ? index - 1 : -1,
+            0 < x && !m_walls.isWall(x, y, Direction::WEST)
+                ? index - m_height : -1,
+        };
+        for (int neighbor : neighbors) {
+            if (neighbor != -1 && distanceData[neighbor] == -1) {
+                distanceData[neighbor] = next;
+                queueData[tail] = neighbor;
+                tail += 1;
+            }
+        }
+    }
+    return distances;
+}
+
+QVector<int> FloodFill::getDistancesByBits(
+        const QVector<QPair<int, int>>& sources) const {
+
+    // Cells are discovered row by row, so distances are recorded in row
+    // major order and only transposed into x * height + y order at the end
+    QVector<int> rowDistances(m_width * m_height, -1);
+    int* rowDistanceData = rowDistances.data();
+    int blocks = m_height * m_blocksPerRow;
+    QVector<quint64> frontier(blocks * WORDS_PER_BLOCK, 0);
+    QVector<quint64> next(blocks * WORDS_PER_BLOCK, 0);
+    QVector<quint64> visited(blocks * WORDS_PER_BLOCK, 0);
+
+    // The blocks that currently hold part of the frontier, and a flag per
+    // block so that each one is only listed once
+    QVector<int> active;
+    QVector<int> candidates;
+    QVector<int> reached;
+    QVector<bool> isListed(blocks, false);
+
+    // Seed the search with the sources
+    for (QPair<int, int> source : sources) {
+        int x = source.first;
+        int y = source.second;
+        int index = getWordIndex(x, y);
+        frontier[index] |= quint64(1) << (x % 64);
+        visited[index] |= quint64(1) << (x % 64);
+        rowDistanceData[y * m_width + x] = 0;
+        int block = index / WORDS_PER_BLOCK;
+        if (!isListed.at(block)) {
+            isListed[block] = true;
+            active.append(block);
+        }
+    }
+    for (int block : active) {
+        isListed[block] = false;
+    }
+
+    int distance = 0;
+    while (!active.isEmpty()) {
+        distance += 1;
+
+        // Cells can only be reached in blocks at or next to the frontier
+        candidates.clear();
+        for (int block : active) {
+            int row = block / m_blocksPerRow;
+            int column = block % m_blocksPerRow;
+            int neighbors[5] = {
+                block,
+                0 < column ? block - 1 : -1,
+                column < m_blocksPerRow - 1 ? block + 1 : -1,
+                0 < row ? block - m_blocksPerRow : -1,
+                row < m_height - 1 ? block + m_blocksPerRow : -1,
+            };
+            for (int neighbor : neighbors) {
+                if (neighbor != -1 && !isListed.at(neighbor)) {
+                    isListed[neighbor] = true;
+                    candidates.append(neighbor);
+                }
+            }
+        }
+
+        // Expand the frontier into those blocks, recording the distance
+        // of every newly reached cell
+        reached.clear();
+        for (int block : candidates) {
+            isListed[block] = false;
+            if (!expandBlock(
+                    block, frontier.constData(), next.data(), visited.data())) {
+                continue;
+            }
+            reached.append(block);
+            int row = block / m_blocksPerRow;
+            int column = block % m_blocksPerRow;
+            for (int i = 0; i < WORDS_PER_BLOCK; i += 1) {
+                quint64 word = next[block * WORDS_PER_BLOCK + i];
+                while (word != 0) {
+                    int x = column * CELLS_PER_BLOCK + i * 64 +
+                        qCountTrailingZeroBits(word);
+                    rowDistanceData[row * m_width + x] = distance;
+                    word &= word - 1;
+                }
+            }
+        }
+
+        // The next frontier becomes the current one; the old frontier is
+        // cleared so that both buffers are empty outside of active blocks
+        for (int block : active) {
+            for (int i = 0; i < WORDS_PER_BLOCK; i += 1) {
+                frontier[block * WORDS_PER_BLOCK + i] = 0;
+            }
+        }
+        frontier.swap(next);
+        active.swap(reached);
+    }
+
+    QVector<int> distances(m_width * m_height);
+    int* distanceData = distances.data();
+    for (int y = 0; y < m_height; y += 1) {
+        for (int x = 0; x < m_width; x += 1) {
+            distanceData[x * m_height + y] = rowDistanceData[y * m_width + x];
+        }
+    }
+    return distances;
+}
+
+int FloodFill::getWordIndex(int x, int y) const {
+    return (y * m_blocksPerRow + x / CELLS_PER_BLOCK) * WORDS_PER_BLOCK +
+        (x % CELLS_PER_BLOCK) / 64;
+}
+
+bool FloodFill::expandBlock(
+        int block,
+        const quint64* frontier,
+        quint64* next,
+        quint64* visited) const {
+
+    int row = block / m_blocksPerRow;
+    int column = block % m_blocksPerRow;
+    int base = block * WORDS_PER_BLOCK;
+    int rowWords = m_blocksPerRow * WORDS_PER_BLOCK;
+    const quint64* openNorth = m_openNorth.constData();
+    const quint64* openEast = m_openEast.constData();
+    const quint64* openSouth = m_openSouth.constData();
+    const quint64* openWest = m_openWest.constData();
+
+    // Cells moving north from the row below and south from the row above
+    quint64 fromBelow[4];
+    quint64 fromAbove[4];
+    for (int i = 0; i < WORDS_PER_BLOCK; i += 1) {
+        int below = base - rowWords + i;
+        int above = base + rowWords + i;
+        fromBelow[i] = 0 < row ? frontier[below] & openNorth[below] : 0;
+        fromAbove[i] =
+            row < m_height - 1 ? frontier[above] & openSouth[above] : 0;
+    }
+
+    // Cells crossing into this block from the neighboring blocks in the row
+    quint64 eastCarry = 0;
+    if (0 < column) {
+        eastCarry = (frontier[base - 1] & openEast[base - 1]) >> 63;
+    }
+    quint64 westCarry = 0;
+    if (column < m_blocksPerRow - 1) {
+        westCarry = (frontier[base + 4] & openWest[base + 4]) << 63;
+    }
+
+#ifdef MMS_FLOOD_FILL_AVX2
+    if (m_method == FloodFillMethod::BIT_PARALLEL_AVX2) {
+        return expandWordsAvx2(
+            frontier + base,
+            openEast + base,
+            openWest + base,
+            fromBelow,
+            fromAbove,
+            eastCarry,
+            westCarry,
+            next + base,
+            visited + base);
+    }
+#endif
+    return expandWordsScalar(
+        frontier + base,
+        openEast + base,
+        openWest + base,
+        fromBelow,
+        fromAbove,
+        eastCarry,
+        westCarry,
+        next + base,
+        visited + base);
+}
+
+bool FloodFill::isAvx2Supported() {
+#ifdef MMS_FLOOD_FILL_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+}
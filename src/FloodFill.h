@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QPair>
+#include <QVector>
+#include <QtGlobal>
+
+#include "WallGrid.h"
+
+namespace mms {
+
+// The ways that FloodFill can search a maze, see FloodFill::getBestMethod()
+enum class FloodFillMethod {
+    QUEUE,
+    BIT_PARALLEL,
+    BIT_PARALLEL_AVX2,
+};
+
+// A breadth first search over the cells of a maze, by one of two methods.
+//
+// The queue method visits one cell at a time, from a flat array of cell
+// indices, so its cost only depends on the number of cells.
+//
+// The bit-parallel method stores each row of the maze as a bitset (one bit
+// per cell), so every step of the search expands the whole frontier with a
+// handful of shifts and masks:
+//
+//     next = ((frontier & openEast)  << 1)   // moves to the east
+//          | ((frontier & openWest)  >> 1)   // moves to the west
+//          | (frontier & openNorth) of the row below
+//          | (frontier & openSouth) of the row above
+//     next &= ~visited
+//
+// Rows are split into blocks of 256 bits and only the blocks at or next to
+// the frontier are expanded, so long, narrow searches don't pay for the
+// whole maze at every step. Blocks are expanded with AVX2 when the CPU
+// supports it, and with plain 64-bit words otherwise.
+//
+// The bit-parallel method only wins when the frontier is wide within rows,
+// i.e., in open or loopy mazes; in a perfect maze the frontier is a few
+// cells wide and the per-block overhead dominates.
+class FloodFill {
+
+public:
+
+    // Uses the best method for the maze
+    explicit FloodFill(const WallGrid& walls);
+    FloodFill(const WallGrid& walls, FloodFillMethod method);
+
+    int getWidth() const;
+    int getHeight() const;
+    FloodFillMethod getMethod() const;
+
+    // The number of steps from the nearest source to each cell, indexed by
+    // x * height + y, or -1 if the cell can't be reached from any source
+    QVector<int> getDistances(const QVector<QPair<int, int>>& sources) const;
+
+    // The queue method, unless the maze is between MIN_BIT_CELLS cells and
+    // MAX_BIT_SIDE cells per side, and has at least MIN_LOOPS_PER_CELL loops
+    // per cell; only then is the bit-parallel method faster, mask building
+    // included. Perfect mazes, like the classic ones, always use the queue.
+    static FloodFillMethod getBestMethod(const WallGrid& walls);
+    static bool isAvx2Supported();
+
+private:
+
+    static const int WORDS_PER_BLOCK;
+    static const int CELLS_PER_BLOCK;
+    static const int MIN_BIT_CELLS;
+    static const int MAX_BIT_SIDE;
+    static const double MIN_LOOPS_PER_CELL;
+
+    int m_width;
+    int m_height;
+    int m_blocksPerRow;
+    FloodFillMethod m_method;
+
+    // Only kept for the queue method
+    WallGrid m_walls;
+
+    // Bit x of row y is set if the cell can be left in that direction;
+    // word i of block b of row y is at (y * m_blocksPerRow + b) * 4 + i.
+    // Only built for the bit-parallel methods.
+    QVector<quint64> m_openNorth;
+    QVector<quint64> m_openEast;
+    QVector<quint64> m_openSouth;
+    QVector<quint64> m_openWest;
+
+    QVector<int> getDistancesByQueue(
+        const QVector<QPair<int, int>>& sources) const;
+    QVector<int> getDistancesByBits(
+        const QVector<QPair<int, int>>& sources) const;
+
+    int getWordIndex(int x, int y) const;
+
+    // Writes the cells reached from the frontier in one step into next,
+    // marks them as visited, and returns whether there were any
+    bool expandBlock(
+        int block,
+        const quint64* frontier,
+        quint64* next,
+        quint64* visited) const;
+};
+
+}
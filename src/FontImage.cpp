@@ -2,6 +2,8 @@
 
 namespace mms {
 
+const int FontImage::NUM_GLYPHS = 128;
+
 QString FontImage::path() {
     return ":/resources/fonts/Unispace-Bold.png";
 }
@@ -16,20 +18,29 @@ QString FontImage::characters() {
     );
 }
 
-
-QMap<QChar, QPair<double, double>> FontImage::positions() {
-    static QMap<QChar, QPair<double, double>> map;
-    if (map.isEmpty()) {
-        // Map from char to fractional position in the image (from 0.0 to 1.0)
+const QVector<QPair<double, double>>& FontImage::glyphs() {
+    // Built exactly once, even if tiles are drawn on several threads at once
+    static const QVector<QPair<double, double>> table = [](){
+        QVector<QPair<double, double>> glyphs(NUM_GLYPHS, {0.0, 0.0});
         QString chars = characters();
         int size = chars.size();
         for (int i = 0; i < size; i += 1) {
             double start = static_cast<double>(i) / static_cast<double>(size);
             double end = static_cast<double>(i + 1) / static_cast<double>(size);
-            map.insert(chars.at(i), {start, end});
+            glyphs[chars.at(i).unicode()] = {start, end};
         }
+        return glyphs;
+    }();
+    return table;
+}
+
+bool FontImage::hasGlyph(QChar c) {
+    if (NUM_GLYPHS <= c.unicode()) {
+        return false;
     }
-    return map;
+    // Every character in the image has some width
+    const QPair<double, double>& glyph = glyphs().at(c.unicode());
+    return glyph.second != 0.0;
 }
 
 } 
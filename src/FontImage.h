@@ -1,8 +1,9 @@
 #pragma once
 
 #include <QChar>
-#include <QMap>
 #include <QPair>
+#include <QString>
+#include <QVector>
 
 namespace mms {
 
@@ -12,7 +13,13 @@ public:
     FontImage() = delete;
     static QString path();
     static QString characters();
-    static QMap<QChar, QPair<double, double>> positions();
+
+    // The start and end of each character in the image, as fractions of its
+    // width (from 0.0 to 1.0), indexed by character code. Characters that
+    // aren't in the image start and end at 0.0, see hasGlyph().
+    static const int NUM_GLYPHS;
+    static const QVector<QPair<double, double>>& glyphs();
+    static bool hasGlyph(QChar c);
 
 };
 
@@ -14,19 +14,15 @@ Coordinate GeometryUtilities::rotateVertexAroundPoint(
     const Coordinate& point,
     const Angle& angle
 ) {
-    Coordinate relativeVertex = Coordinate::Cartesian(
-        vertex.getX() - point.getX(),
-        vertex.getY() - point.getY()
-    );
-    Coordinate rotatedRelativeVertex = Coordinate::Polar(
-        relativeVertex.getRho(),
-        relativeVertex.getTheta() + angle
-    );
-    Coordinate rotatedVertex = Coordinate::Cartesian(
-        rotatedRelativeVertex.getX() + point.getX(),
-        rotatedRelativeVertex.getY() + point.getY()
-    );
-    return rotatedVertex;
+    return rotateVertexAroundPoint(vertex, point, Rotation(angle));
 }
 
-} 
+Coordinate GeometryUtilities::rotateVertexAroundPoint(
+    const Coordinate& vertex,
+    const Coordinate& point,
+    const Rotation& rotation
+) {
+    return rotation.rotate(vertex - point) + point;
+}
+
+}
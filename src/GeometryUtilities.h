@@ -2,6 +2,7 @@
 
 #include "units/Angle.h"
 #include "units/Coordinate.h"
+#include "units/Rotation.h"
 
 namespace mms {
 
@@ -19,6 +20,12 @@ public:
         const Coordinate& vertex,
         const Coordinate& point,
         const Angle& angle);
+
+    // The same, but with the sine and cosine of the angle already computed
+    static Coordinate rotateVertexAroundPoint(
+        const Coordinate& vertex,
+        const Coordinate& point,
+        const Rotation& rotation);
 };
 
 } 
@@ -0,0 +1,125 @@
+#include "LogConsole.h"
+
+#include <QDir>
+#include <QFont>
+#include <QFontDatabase>
+#include <QStringList>
+
+namespace mms {
+
+const int LogConsole::MAX_LINES = 10000;
+const int LogConsole::REFRESH_INTERVAL_MS = 50;
+
+LogConsole::LogConsole(QWidget* parent) :
+    QPlainTextEdit(parent),
+    m_lines(RingBuffer<QString>(MAX_LINES)),
+    m_numUnshown(0),
+    m_refreshTimer(new QTimer(this)),
+    m_filter(QString()),
+    m_logFile(nullptr) {
+
+    setReadOnly(true);
+    setLineWrapMode(QPlainTextEdit::NoWrap);
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    font.setPointSize(10);
+    document()->setDefaultFont(font);
+
+    // The document drops its oldest lines once it's full, just like the ring
+    setMaximumBlockCount(MAX_LINES);
+
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_refreshTimer, &QTimer::timeout, this, [=](){
+        refresh();
+    });
+}
+
+QString LogConsole::logFilePath(const QString& name) {
+    return QDir::temp().filePath("mms-" + name + ".log");
+}
+
+void LogConsole::reset(const QString& logFilePath) {
+
+    m_refreshTimer->stop();
+    m_lines.clear();
+    m_numUnshown = 0;
+    clear();
+
+    if (m_logFile != nullptr) {
+        delete m_logFile;
+        m_logFile = nullptr;
+    }
+    setToolTip("");
+    if (logFilePath.isEmpty()) {
+        return;
+    }
+
+    // Writes to the file are buffered, and flushed on each refresh
+    QFile* logFile = new QFile(logFilePath, this);
+    if (!logFile->open(
+            QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        delete logFile;
+        return;
+    }
+    m_logFile = logFile;
+    setToolTip("Full output: " + logFilePath);
+}
+
+void LogConsole::appendLine(const QString& line) {
+
+    if (m_logFile != nullptr) {
+        m_logFile->write(line.toUtf8());
+        m_logFile->write("\n");
+    }
+
+    // Once the ring is full, the newest line replaces the oldest
+    if (m_lines.isFull()) {
+        m_lines.dequeue();
+    }
+    m_lines.enqueue(line);
+    m_numUnshown = std::min(m_numUnshown + 1, m_lines.size());
+
+    if (!m_refreshTimer->isActive()) {
+        m_refreshTimer->start();
+    }
+}
+
+void LogConsole::setFilter(const QString& filter) {
+    // Redraw the lines that are still in the ring
+    m_filter = filter;
+    QStringList shown;
+    for (int i = 0; i < m_lines.size(); i += 1) {
+        if (matches(m_lines.at(i))) {
+            shown.append(m_lines.at(i));
+        }
+    }
+    m_numUnshown = 0;
+    setPlainText(shown.join("\n"));
+    moveCursor(QTextCursor::End);
+}
+
+void LogConsole::refresh() {
+
+    // Show all of the new lines with a single append, so that the document is
+    // laid out once per refresh rather than once per line
+    QStringList shown;
+    for (int i = m_lines.size() - m_numUnshown; i < m_lines.size(); i += 1) {
+        if (matches(m_lines.at(i))) {
+            shown.append(m_lines.at(i));
+        }
+    }
+    m_numUnshown = 0;
+    if (!shown.isEmpty()) {
+        appendPlainText(shown.join("\n"));
+    }
+
+    if (m_logFile != nullptr) {
+        m_logFile->flush();
+    }
+}
+
+bool LogConsole::matches(const QString& line) const {
+    return m_filter.isEmpty() || line.contains(m_filter, Qt::CaseInsensitive);
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QFile>
+#include <QPlainTextEdit>
+#include <QString>
+#include <QTimer>
+
+#include "RingBuffer.h"
+
+namespace mms {
+
+// A read-only pane for build and run output. Chatty processes can print
+// thousands of lines per second, so lines are kept in a fixed-size ring and
+// shown in batches, at most once per refresh interval. Only the most recent
+// lines are kept on screen, but every line is also written to a log file.
+class LogConsole : public QPlainTextEdit {
+
+    Q_OBJECT
+
+public:
+
+    LogConsole(QWidget* parent = 0);
+
+    // The path of a log file in the temp directory, e.g., "mms-build.log"
+    static QString logFilePath(const QString& name);
+
+    // Clears the console and closes the log file, if any; if a path is given,
+    // the following lines are also written to a new log file at that path
+    void reset(const QString& logFilePath = QString());
+
+    // The line may contain newlines, in which case it's shown as many lines
+    void appendLine(const QString& line);
+
+    // Only lines that contain the filter (ignoring case) are shown; the log
+    // file always gets every line
+    void setFilter(const QString& filter);
+
+private:
+
+    static const int MAX_LINES;
+    static const int REFRESH_INTERVAL_MS;
+
+    // The most recent lines
+    RingBuffer<QString> m_lines;
+
+    // The newest lines, which haven't been shown yet
+    int m_numUnshown;
+    QTimer* m_refreshTimer;
+    void refresh();
+
+    QString m_filter;
+    bool matches(const QString& line) const;
+
+    QFile* m_logFile;
+
+};
+
+}
@@ -15,7 +15,7 @@ Map::Map(QWidget* parent) :
     QOpenGLWidget(parent),
     m_maze(nullptr),
     m_view(nullptr),
-    m_mouseGraphic(nullptr),
+    m_mouseGraphics(QVector<const MouseGraphic*>()),
     m_windowWidth(0),
     m_windowHeight(0),
     m_textureAtlas(nullptr) {
@@ -23,24 +23,24 @@ Map::Map(QWidget* parent) :
 }
 
 void Map::setMaze(const Maze* maze) {
-    ASSERT_TR(m_mouseGraphic == nullptr);
+    ASSERT_TR(m_mouseGraphics.isEmpty());
     m_maze = maze;
     m_view = nullptr;
 }
 
-void Map::setView(const MazeView* view) {
+void Map::setView(MazeView* view) {
     if (view != nullptr) {
         ASSERT_FA(m_maze == nullptr);
     }
     m_view = view;
 }
 
-void Map::setMouseGraphic(const MouseGraphic* mouseGraphic) {
-    if (mouseGraphic != nullptr) {
+void Map::setMouseGraphics(QVector<const MouseGraphic*> mouseGraphics) {
+    if (!mouseGraphics.isEmpty()) {
         ASSERT_FA(m_maze == nullptr);
         ASSERT_FA(m_view == nullptr);
     }
-    m_mouseGraphic = mouseGraphic;
+    m_mouseGraphics = mouseGraphics;
 }
 
 QStringList Map::getOpenGLVersionInfo() {
@@ -118,9 +118,13 @@ void Map::paintGL() {
         return;
     }
 
+    // Write the tile changes made since the last frame
+    m_view->flushUpdates();
+
+    // All of the mice share a single buffer, and thus a single draw call
     QVector<TriangleGraphic> mouseBuffer;
-    if (m_mouseGraphic != nullptr) {
-        mouseBuffer = m_mouseGraphic->draw();
+    for (const MouseGraphic* mouseGraphic : m_mouseGraphics) {
+        mouseBuffer.append(mouseGraphic->draw());
     }
 
     // Re-populate both vertex buffer objects
@@ -144,7 +148,7 @@ void Map::paintGL() {
         );
     }
 
-    // Draw the mouse
+    // Draw the mice
     drawMap(
         &m_polygonProgram,
         &m_polygonVAO,
@@ -28,8 +28,8 @@ public:
     Map(QWidget* parent = 0);
 
     void setMaze(const Maze* maze);
-    void setView(const MazeView* view);
-    void setMouseGraphic(const MouseGraphic* mouseGraphic);
+    void setView(MazeView* view);
+    void setMouseGraphics(QVector<const MouseGraphic*> mouseGraphics);
 
     // Retrieves OpenGL version info
     QStringList getOpenGLVersionInfo();
@@ -54,8 +54,8 @@ private:
 
     // No ownership here - only pointers
     const Maze* m_maze;
-    const MazeView* m_view;
-    const MouseGraphic* m_mouseGraphic;
+    MazeView* m_view;
+    QVector<const MouseGraphic*> m_mouseGraphics;
 
     // The map's window size, in pixels
     int m_windowWidth;
@@ -1,13 +1,20 @@
 #include "Maze.h"
 
+#include <QByteArray>
 #include <QFile>
-#include <QTextStream>
-#include <QQueue>
+
+#include <climits>
 
 #include "AssertMacros.h"
+#include "FloodFill.h"
 
 namespace mms {
 
+const quint8 Maze::SENSE_FRONT = 1 << 0;
+const quint8 Maze::SENSE_RIGHT = 1 << 1;
+const quint8 Maze::SENSE_BACK = 1 << 2;
+const quint8 Maze::SENSE_LEFT = 1 << 3;
+
 Maze* Maze::fromFile(const QString& path) {
 
     // Open the file
@@ -19,56 +26,130 @@ Maze* Maze::fromFile(const QString& path) {
         return nullptr;
     }
 
-    // Read the lines into a vector
-    QString line;
-    QVector<QString> lines;
-    QTextStream stream(&file);
-    while (stream.readLineInto(&line)) {
-        lines.append(line);
+    // Map the file into memory; resources and special files can't always be
+    // mapped, so fall back to reading them. Either way, the parsers work
+    // directly on the bytes and the mapping is released when file closes.
+    QByteArray contents;
+    qint64 size = file.size();
+    const char* data = reinterpret_cast<const char*>(file.map(0, size));
+    if (data == nullptr) {
+        contents = file.readAll();
+        data = contents.constData();
+        size = contents.size();
+    }
+
+    // Binary files hold a small value per cell, which no text file starts
+    // with (besides whitespace, in which case the binary parse fails fast)
+    if (0 < size && static_cast<quint8>(data[0]) < 16) {
+        Maze* maze = fromMazFile(data, size);
+        if (maze != nullptr) {
+            return maze;
+        }
+    }
+
+    // Otherwise, sniff the text format from the first non-whitespace byte
+    qint64 first = 0;
+    while (first < size && isSpace(data[first])) {
+        first += 1;
+    }
+    if (first == size) {
+        return nullptr;
+    }
+    if (data[first] == '+') {
+        return fromMapFile(data, size);
+    }
+    if (isDigit(data[first])) {
+        return fromNumFile(data, size);
+    }
+    return nullptr;
+}
+
+Maze* Maze::fromWalls(const WallGrid& walls) {
+    if (walls.getWidth() == 0 || walls.getHeight() == 0) {
+        return nullptr;
     }
+    if (!isEnclosed(walls)) {
+        return nullptr;
+    }
+    return new Maze(walls);
+}
 
-    // Try map format first, then num
-    Maze* maze = fromMapFile(lines);
-    if (maze != nullptr) {
-        return maze;
+bool Maze::isValid(const WallGrid& walls) {
+    if (walls.getWidth() == 0 || walls.getHeight() == 0) {
+        return false;
+    }
+    if (!isEnclosed(walls)) {
+        return false;
     }
-    return fromNumFile(lines);
+    FloodFill floodFill(walls);
+    QVector<int> distances = floodFill.getDistances({{0, 0}});
+    for (QPair<int, int> center : getCenterPositions(
+            walls.getWidth(), walls.getHeight())) {
+        if (distances.at(center.first * walls.getHeight() + center.second)
+                != -1) {
+            return true;
+        }
+    }
+    return false;
 }
 
 int Maze::getWidth() const {
-    return m_tiles.size();
+    return m_walls.getWidth();
 }
 
 int Maze::getHeight() const {
-    return m_tiles.at(0).size();
+    return m_walls.getHeight();
 }
 
-const Tile* Maze::getTile(int x, int y) const {
+int Maze::getDistance(int x, int y) const {
     ASSERT_LE(0, x);
     ASSERT_LE(0, y);
     ASSERT_LT(x, getWidth());
     ASSERT_LT(y, getHeight());
-    return &m_tiles.at(x).at(y);
+    return m_distances.at(x * getHeight() + y);
 }
 
 bool Maze::isInCenter(QPair<int, int> location) const {
     return getCenterPositions(getWidth(), getHeight()).contains(location);
 }
 
-Maze::Maze(BasicMaze basicMaze) {
-    QVector<QVector<int>> distances = getDistances(basicMaze);
-    for (int x = 0; x < basicMaze.size(); x += 1) {
-        QVector<Tile> column;
-        for (int y = 0; y < basicMaze.at(x).size(); y += 1) {
-            Tile tile(x, y, distances.at(x).at(y), basicMaze.at(x).at(y));
-            tile.initPolygons(basicMaze.size(), basicMaze.at(x).size());
-            column.append(tile);
+bool Maze::isWall(int x, int y, Direction direction) const {
+    return m_walls.isWall(x, y, direction);
+}
+
+const WallGrid& Maze::getWalls() const {
+    return m_walls;
+}
+
+quint8 Maze::getSenseMask(int x, int y, Direction heading) const {
+    quint16 masks = m_senseMasks.at(x * getHeight() + y);
+    return (masks >> (4 * static_cast<int>(heading))) & 0xF;
+}
+
+Maze::Maze(const WallGrid& walls) :
+    m_walls(walls),
+    m_distances(getDistances(walls)) {
+    int width = walls.getWidth();
+    int height = walls.getHeight();
+    m_senseMasks.reserve(width * height);
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            quint8 mask = walls.getWallMask(x, y);
+
+            // Rotating the NESW mask by the heading yields a mask whose bits
+            // are front, right, back, left - see the SENSE_* constants
+            quint16 masks = 0;
+            for (Direction heading : DIRECTIONS()) {
+                int h = static_cast<int>(heading);
+                quint16 sense = ((mask >> h) | (mask << (4 - h))) & 0xF;
+                masks |= sense << (4 * h);
+            }
+            m_senseMasks.append(masks);
         }
-        m_tiles.append(column);
     }
 }
 
-Maze* Maze::fromMapFile(QVector<QString> lines) {
+Maze* Maze::fromMapFile(const char* data, qint64 size) {
     // Format:
     //
     //     +---+---+---+
@@ -77,69 +158,92 @@ Maze* Maze::fromMapFile(QVector<QString> lines) {
     //     |   |       |
     //     +---+---+---+
 
-    // Flip the lines to process them from bottom to top
-    for (int i = 0; i < lines.size() / 2; i += 1) {
-        int j = lines.size() - 1 - i;
-        QString one = lines.at(i);
-        QString two = lines.at(j);
-        lines[i] = two;
-        lines[j] = one;
+    // Find the bounds of each line, dropping blank lines at either end
+    QVector<QPair<qint64, qint64>> lines;
+    qint64 begin = 0;
+    while (begin < size) {
+        qint64 end = begin;
+        while (end < size && data[end] != '\n') {
+            end += 1;
+        }
+        qint64 next = end + 1;
+        if (begin < end && data[end - 1] == '\r') {
+            end -= 1;
+        }
+        lines.append({begin, end});
+        begin = next;
+    }
+    while (!lines.isEmpty() && isBlank(data, lines.first())) {
+        lines.removeFirst();
+    }
+    while (!lines.isEmpty() && isBlank(data, lines.last())) {
+        lines.removeLast();
     }
 
-    BasicMaze basicMaze;
-    for (int y = 0; y < lines.size() / 2; y += 1) {
-	    for (int x = 0; x < lines.at(y).size() / 4; x += 1) {
+    // Horizontal and vertical wall lines must alternate, starting and ending
+    // horizontally, every line must be the same number of cells wide, and
+    // the vertical lines must reach the eastern edge of the maze
+    if (lines.size() % 2 != 1) {
+        return nullptr;
+    }
+    int width = (lines.first().second - lines.first().first) / 4;
+    int height = lines.size() / 2;
+    if (width == 0 || height == 0) {
+        return nullptr;
+    }
+    for (int i = 0; i < lines.size(); i += 1) {
+        qint64 length = lines.at(i).second - lines.at(i).first;
+        if (length / 4 != width || (i % 2 == 1 && length == 4 * width)) {
+            return nullptr;
+        }
+    }
 
-            // Fill out the maze as necessary
-            while (basicMaze.size() <= x) {
-                QVector<QMap<Direction, bool>> column;
-                basicMaze.append(column);
+    // Read the walls straight into the grid. The lines run from top to bottom
+    // and the rows from bottom to top, so row y's southern edge is at line
+    // lines.size() - 1 - 2 * y, and its vertical walls are on the line above:
+    //
+    //    west v
+    //         +---+ < north
+    //         |   |
+    // south > +---+
+    //             ^ east
+    //
+    WallGrid walls(width, height);
+    for (int y = 0; y <= height; y += 1) {
+        const char* south = data + lines.at(lines.size() - 1 - 2 * y).first;
+        for (int x = 0; x < width; x += 1) {
+            bool isWall = south[4 * x + 2] != ' ';
+            if (y < height) {
+                walls.setWall(x, y, Direction::SOUTH, isWall);
             }
-            while (basicMaze.at(x).size() <= y) {
-                QMap<Direction, bool> walls;
-                basicMaze[x].append(walls);
+            else {
+                walls.setWall(x, y - 1, Direction::NORTH, isWall);
             }
-
-            // Calculate the edges of the cell:
-            //
-            //    west v
-            //         +---+ < north
-            //         |   |
-            // south > +---+
-            //             ^ east
-            //
-            int north = 2 * (y + 1);
-            int south = 2 * (y + 0);
-            int east = 4 * (x + 1);
-            int west = 4 * (x + 0);
-
-            // Check bounds
-            if (lines.size() <= north) {
-                return nullptr;
+        }
+        if (y == height) {
+            break;
+        }
+        const char* middle = data + lines.at(lines.size() - 2 - 2 * y).first;
+        for (int x = 0; x <= width; x += 1) {
+            bool isWall = middle[4 * x] != ' ';
+            if (x < width) {
+                walls.setWall(x, y, Direction::WEST, isWall);
             }
-            if (lines.at(south + 1).size() <= east) {
-                return nullptr;
+            else {
+                walls.setWall(x - 1, y, Direction::EAST, isWall);
             }
-
-            // Add values for the current cell
-            QMap<Direction, bool> walls;
-            walls[Direction::NORTH] = lines.at(north).at(west + 2) != ' ';
-            walls[Direction::EAST]  = lines.at(south + 1).at(east) != ' ';
-            walls[Direction::SOUTH] = lines.at(south).at(west + 2) != ' ';
-            walls[Direction::WEST]  = lines.at(south + 1).at(west) != ' ';
-            basicMaze[x][y] = walls;
         }
     }
 
-    // Check if the maze is valid
-    if (!isValid(basicMaze)) {
+    // Both sides of every wall come from the same character, so the maze
+    // is consistent by construction and only has to be enclosed
+    if (!isEnclosed(walls)) {
         return nullptr;
     }
-
-    return new Maze(basicMaze);
+    return new Maze(walls);
 }
 
-Maze* Maze::fromNumFile(QVector<QString> lines) {
+Maze* Maze::fromNumFile(const char* data, qint64 size) {
     // Format:
     //
     //     X Y N E S W
@@ -161,188 +265,212 @@ Maze* Maze::fromNumFile(QVector<QString> lines) {
     //     |   |       |
     //     +---+---+---+
 
-    BasicMaze basicMaze;
-    for (QString line : lines) {
+    // Parse the records; the dimensions aren't known until the end
+    QVector<CellWalls> cells;
+    int width = 0;
+    int height = 0;
+    qint64 position = 0;
+    while (position < size) {
+
+        // Read up to six numbers from the line
+        int values[6];
+        int count = 0;
+        while (position < size && data[position] != '\n') {
+            char c = data[position];
+            if (isSpace(c)) {
+                position += 1;
+                continue;
+            }
+            if (!isDigit(c) || count == 6) {
+                return nullptr;
+            }
+            int value = 0;
+            while (position < size && isDigit(data[position])) {
+                if (value > (INT_MAX - 9) / 10) {
+                    return nullptr;
+                }
+                value = value * 10 + (data[position] - '0');
+                position += 1;
+            }
+            values[count] = value;
+            count += 1;
+        }
+        position += 1;
 
-        // Tokenize the line
-        QStringList tokens = line.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() != 6) {
+        // Skip blank lines, reject incomplete ones
+        if (count == 0) {
+            continue;
+        }
+        if (count != 6) {
             return nullptr;
         }
 
-        // Extract numeric values
-        bool ok = true;
-        int x = tokens.at(0).toInt(&ok);
-        int y = tokens.at(1).toInt(&ok);
-        bool n = tokens.at(2).toInt(&ok) == 1;
-        bool e = tokens.at(3).toInt(&ok) == 1;
-        bool s = tokens.at(4).toInt(&ok) == 1;
-        bool w = tokens.at(5).toInt(&ok) == 1;
-        if (!ok) {
-            return nullptr;
+        // Add values for the current cell
+        CellWalls cell;
+        cell.x = values[0];
+        cell.y = values[1];
+        cell.walls = 0;
+        for (int i = 0; i < 4; i += 1) {
+            if (values[2 + i] == 1) {
+                cell.walls |= WallGrid::getWallBit(DIRECTIONS().at(i));
+            }
         }
+        cells.append(cell);
+        width = qMax(width, cell.x + 1);
+        height = qMax(height, cell.y + 1);
+    }
 
-        // Fill out the maze as necessary
-        while (basicMaze.size() <= x) {
-            QVector<QMap<Direction, bool>> column;
-            basicMaze.append(column);
+    // Every cell has to be listed exactly once. Checking the count first also
+    // keeps a stray large coordinate from allocating an enormous maze, and
+    // with the right count, a cell is only missing if another is repeated.
+    if (width == 0 || qint64(width) * height != cells.size()) {
+        return nullptr;
+    }
+    QVector<quint8> masks(width * height, 0);
+    QVector<bool> seen(width * height, false);
+    for (const CellWalls& cell : cells) {
+        int index = cell.x * height + cell.y;
+        if (seen.at(index)) {
+            return nullptr;
         }
-        while (basicMaze.at(x).size() <= y) {
-            QMap<Direction, bool> walls;
-            basicMaze[x].append(walls);
+        seen[index] = true;
+        masks[index] = cell.walls;
+    }
+    return fromCellMasks(width, height, masks.constData());
+}
+
+Maze* Maze::fromMazFile(const char* data, qint64 size) {
+    // Format:
+    //
+    //     One byte per cell, column by column from the southwest corner,
+    //     for a square maze. The low four bits of each byte are the walls
+    //     of the cell: 1 = north, 2 = east, 4 = south, 8 = west.
+    //
+    // This happens to match the layout and bit order used everywhere else,
+    // so the bytes are validated in place without being copied.
+
+    int side = 0;
+    while (qint64(side + 1) * (side + 1) <= size) {
+        side += 1;
+    }
+    if (side == 0 || qint64(side) * side != size) {
+        return nullptr;
+    }
+    const quint8* masks = reinterpret_cast<const quint8*>(data);
+    for (qint64 i = 0; i < size; i += 1) {
+        if (15 < masks[i]) {
+            return nullptr;
         }
+    }
+    return fromCellMasks(side, side, masks);
+}
 
-        // Add values for the current cell
-        QMap<Direction, bool> walls;
-        walls[Direction::NORTH] = n;
-        walls[Direction::EAST] = e;
-        walls[Direction::SOUTH] = s;
-        walls[Direction::WEST] = w;
-        basicMaze[x][y] = walls;
+Maze* Maze::fromCellMasks(int width, int height, const quint8* masks) {
+
+    // Both sides of each wall must agree before they can be packed
+    if (!isConsistent(width, height, masks)) {
+        return nullptr;
+    }
+
+    // Pack the walls; each cell declares its own southern and western walls,
+    // and the cells along the northern and eastern edges declare those edges
+    WallGrid walls(width, height);
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            quint8 mask = masks[x * height + y];
+            for (Direction direction : DIRECTIONS()) {
+                bool isOwner = (
+                    direction == Direction::SOUTH ||
+                    direction == Direction::WEST ||
+                    (direction == Direction::NORTH && y == height - 1) ||
+                    (direction == Direction::EAST && x == width - 1)
+                );
+                if (isOwner) {
+                    bool isWall = mask & WallGrid::getWallBit(direction);
+                    walls.setWall(x, y, direction, isWall);
+                }
+            }
+        }
     }
 
     // Check if the maze is valid
-    if (!isValid(basicMaze)) {
+    if (!isEnclosed(walls)) {
         return nullptr;
     }
 
-    return new Maze(basicMaze);
+    return new Maze(walls);
 }
 
-bool Maze::isValid(const BasicMaze& basicMaze) {
-    return (
-        isNonempty(basicMaze) &&
-        isRectangular(basicMaze) &&
-        isEnclosed(basicMaze) &&
-        isConsistent(basicMaze)
-    );
+bool Maze::isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
 }
 
-bool Maze::isNonempty(const BasicMaze& basicMaze) {
-    return 0 < basicMaze.size() && 0 < basicMaze.at(0).size();
+bool Maze::isDigit(char c) {
+    return '0' <= c && c <= '9';
 }
 
-bool Maze::isRectangular(const BasicMaze& basicMaze) {
-    for (int x = 0; x < basicMaze.size() - 1; x += 1) {
-        if (basicMaze.at(x).size() != basicMaze.at(x + 1).size()) {
+bool Maze::isBlank(const char* data, QPair<qint64, qint64> line) {
+    for (qint64 i = line.first; i < line.second; i += 1) {
+        if (!isSpace(data[i])) {
             return false;
         }
     }
     return true;
 }
 
-bool Maze::isEnclosed(const BasicMaze& basicMaze) {
-    int width = basicMaze.size();
-    int height = basicMaze.at(0).size();
+bool Maze::isEnclosed(const WallGrid& walls) {
+    int width = walls.getWidth();
+    int height = walls.getHeight();
     for (int x = 0; x < width; x += 1) {
-        for (int y = 0; y < height; y += 1) {
-            QMap<Direction, bool> walls = basicMaze.at(x).at(y);
-            if (x == 0 && !walls.value(Direction::WEST)) {
-                return false;
-            }
-            if (y == 0 && !walls.value(Direction::SOUTH)) {
-                return false;
-            }
-            if (x == width - 1 && !walls.value(Direction::EAST)) {
-                return false;
-            }
-            if (y == height - 1 && !walls.value(Direction::NORTH)) {
-                return false;
-            }
+        if (!walls.isWall(x, 0, Direction::SOUTH)) {
+            return false;
+        }
+        if (!walls.isWall(x, height - 1, Direction::NORTH)) {
+            return false;
         }
     }
-    return true;
-}
-
-bool Maze::isConsistent(const BasicMaze& basicMaze) {
-    int width = basicMaze.size();
-    int height = basicMaze.at(0).size();
-    for (int x = 0; x < basicMaze.size(); x += 1) {
-        for (int y = 0; y < basicMaze.at(x).size(); y += 1) {
-            QMap<Direction, bool> walls = basicMaze.at(x).at(y);
-            if (
-                0 < x &&
-                walls.value(Direction::WEST) &&
-                !basicMaze.at(x - 1).at(y).value(Direction::EAST)
-            ) {
-                return false;
-            }
-            if (
-                0 < y &&
-                walls.value(Direction::SOUTH) &&
-                !basicMaze.at(x).at(y - 1).value(Direction::NORTH)
-            ) {
-                return false;
-            }
-            if (
-                x < width - 1 &&
-                walls.value(Direction::EAST) &&
-                !basicMaze.at(x + 1).at(y).value(Direction::WEST)
-            ) {
-                return false;
-            }
-            if (
-                y < height - 1 &&
-                walls.value(Direction::NORTH) &&
-                !basicMaze.at(x).at(y + 1).value(Direction::SOUTH)
-            ) {
-                return false;
-            }
+    for (int y = 0; y < height; y += 1) {
+        if (!walls.isWall(0, y, Direction::WEST)) {
+            return false;
+        }
+        if (!walls.isWall(width - 1, y, Direction::EAST)) {
+            return false;
         }
     }
     return true;
 }
 
-QVector<QVector<int>> Maze::getDistances(BasicMaze basicMaze) {
-
-    // Initialize all positions with default value
-    QVector<QVector<int>> distances;
-    for (int x = 0; x < basicMaze.size(); x += 1) {
-        QVector<int> column;
-        for (int y = 0; y < basicMaze.at(x).size(); y += 1) {
-            column.append(-1);
-        }
-        distances.append(column);
-    }
-
-    // Set the distances of the center positions to 0 and enqueue them
-    QQueue<QPair<int, int>> discovered;
-    int width = basicMaze.size();
-    int height = basicMaze.at(0).size();
-    for (QPair<int, int> position : getCenterPositions(width, height)) {
-        distances[position.first][position.second] = 0;
-        discovered.enqueue(position);
-    }
-
-    // Perform a breadth first search
-    while (!discovered.empty()){
-        QPair<int, int> position = discovered.dequeue();
-        int x = position.first;
-        int y = position.second;
-        for (Direction direction : DIRECTIONS()) {
-            if (!basicMaze.at(x).at(y).value(direction)) {
-                int nx = x;
-                int ny = y;
-                if (direction == Direction::NORTH) {
-                    ny += 1;
-                }
-                if (direction == Direction::EAST) {
-                    nx += 1;
-                }
-                if (direction == Direction::SOUTH) {
-                    ny -= 1;
-                }
-                if (direction == Direction::WEST) {
-                    nx -= 1;
+bool Maze::isConsistent(int width, int height, const quint8* masks) {
+    // Compare each cell's northern and eastern walls with the southern and
+    // western walls of its neighbors, directly on the masks
+    quint8 north = WallGrid::getWallBit(Direction::NORTH);
+    quint8 east = WallGrid::getWallBit(Direction::EAST);
+    quint8 south = WallGrid::getWallBit(Direction::SOUTH);
+    quint8 west = WallGrid::getWallBit(Direction::WEST);
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            quint8 mask = masks[x * height + y];
+            if (y + 1 < height) {
+                quint8 above = masks[x * height + y + 1];
+                if (bool(mask & north) != bool(above & south)) {
+                    return false;
                 }
-                if (distances.at(nx).at(ny) == -1) {
-                    distances[nx][ny] = distances.at(x).at(y) + 1;
-                    discovered.enqueue({nx, ny});
+            }
+            if (x + 1 < width) {
+                quint8 right = masks[(x + 1) * height + y];
+                if (bool(mask & east) != bool(right & west)) {
+                    return false;
                 }
             }
         }
     }
-    return distances;
+    return true;
+}
+
+QVector<int> Maze::getDistances(const WallGrid& walls) {
+    FloodFill floodFill(walls);
+    return floodFill.getDistances(
+        getCenterPositions(walls.getWidth(), walls.getHeight()));
 }
 
 QVector<QPair<int, int>> Maze::getCenterPositions(int width, int height) {
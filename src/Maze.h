@@ -1,43 +1,80 @@
 #pragma once
 
+#include <QPair>
 #include <QString>
 #include <QVector>
+#include <QtGlobal>
 
-#include "Tile.h"
+#include "Direction.h"
+#include "WallGrid.h"
 
 namespace mms {
 
-typedef QVector<QVector<QMap<Direction, bool>>> BasicMaze;
-
 class Maze {
 
 public:
 
     static Maze* fromFile(const QString& path);
 
+    // Returns nullptr unless the walls are nonempty and enclosed, which is
+    // all that's required of maze files
+    static Maze* fromWalls(const WallGrid& walls);
+
+    // Whether the maze is nonempty, enclosed, and its center can be reached
+    // from the start; maze files only need to be enclosed
+    static bool isValid(const WallGrid& walls);
+
     int getWidth() const;
     int getHeight() const;
-    const Tile* getTile(int x, int y) const;
+    int getDistance(int x, int y) const;
     bool isInCenter(QPair<int, int> location) const;
+    static QVector<QPair<int, int>> getCenterPositions(int width, int height);
+    bool isWall(int x, int y, Direction direction) const;
+    const WallGrid& getWalls() const;
+
+    // The walls around a cell relative to a heading, one bit per SENSE_* value
+    static const quint8 SENSE_FRONT;
+    static const quint8 SENSE_RIGHT;
+    static const quint8 SENSE_BACK;
+    static const quint8 SENSE_LEFT;
+    quint8 getSenseMask(int x, int y, Direction heading) const;
+
 private:
 
-    QVector<QVector<Tile>> m_tiles;
-    explicit Maze(BasicMaze basicMaze);
+    // Cell data is stored as flat arrays, indexed by x * height + y
+    WallGrid m_walls;
+    QVector<int> m_distances;
+    QVector<quint16> m_senseMasks; // four bits (see SENSE_*) per heading
+
+    explicit Maze(const WallGrid& walls);
+
+    // Maze file formats, parsed in place from the file's bytes
+    static Maze* fromMapFile(const char* data, qint64 size);
+    static Maze* fromNumFile(const char* data, qint64 size);
+    static Maze* fromMazFile(const char* data, qint64 size);
 
-    // Maze file formats
-    static Maze* fromMapFile(QVector<QString> lines);
-    static Maze* fromNumFile(QVector<QString> lines);
+    // A cell as declared by a num file, in the format of
+    // WallGrid::getWallMask(). Unlike a WallGrid, the two sides of a wall
+    // can disagree, which is why these only live until they're validated.
+    struct CellWalls {
+        int x;
+        int y;
+        quint8 walls;
+    };
 
-    // Validate the maze
-    static bool isValid(const BasicMaze& basicMaze);
-    static bool isNonempty(const BasicMaze& basicMaze);
-    static bool isRectangular(const BasicMaze& basicMaze);
-    static bool isEnclosed(const BasicMaze& basicMaze);
-    static bool isConsistent(const BasicMaze& basicMaze);
+    // Byte classification for the parsers
+    static bool isSpace(char c);
+    static bool isDigit(char c);
+    static bool isBlank(const char* data, QPair<qint64, qint64> line);
+
+    // Validate the maze, returns nullptr if it's invalid; masks holds one
+    // wall mask per cell, indexed by x * height + y
+    static Maze* fromCellMasks(int width, int height, const quint8* masks);
+    static bool isEnclosed(const WallGrid& walls);
+    static bool isConsistent(int width, int height, const quint8* masks);
 
     // Populate distances
-    static QVector<QVector<int>> getDistances(BasicMaze basicMaze);
-    static QVector<QPair<int, int>> getCenterPositions(int width, int height);
+    static QVector<int> getDistances(const WallGrid& walls);
 
 };
 
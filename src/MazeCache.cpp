@@ -0,0 +1,141 @@
+#include "MazeCache.h"
+
+#include <QFileInfo>
+
+#include "AssertMacros.h"
+#include "MazeCorpus.h"
+
+namespace mms {
+
+const qint64 MazeCache::MAX_BYTES = 64 * 1024 * 1024;
+
+MazeCache::MazeCache() : m_bytes(0) {
+}
+
+MazeCache::~MazeCache() {
+    for (Slot* slot : m_slots) {
+        deleteSlot(slot);
+    }
+}
+
+MazeCache::Entry* MazeCache::get(const QString& path) {
+    for (int i = 0; i < m_slots.size(); i += 1) {
+        Slot* slot = m_slots.at(i);
+        if (slot->path != path || slot->isStale) {
+            continue;
+        }
+
+        // The file was modified, so the entry is stale. The most recently
+        // used one is presumably being shown, so it's only marked, and
+        // trim() deletes it once the caller has switched to another entry.
+        Slot current = *slot;
+        stat(&current);
+        if (
+            current.lastModified != slot->lastModified ||
+            current.fileSize != slot->fileSize
+        ) {
+            if (i == 0) {
+                slot->isStale = true;
+                return nullptr;
+            }
+            m_slots.removeAt(i);
+            m_bytes -= slot->bytes;
+            deleteSlot(slot);
+            return nullptr;
+        }
+        m_slots.move(i, 0);
+        return &slot->entry;
+    }
+    return nullptr;
+}
+
+MazeCache::Entry* MazeCache::insert(const QString& path, Maze* maze) {
+
+    // The truth has every wall declared; its text is up to the caller
+    Slot* slot = new Slot();
+    slot->path = path;
+    slot->isStale = false;
+    slot->entry.maze = maze;
+    slot->entry.truth = new MazeView(maze, true);
+    slot->entry.belief = new MazeView(maze, false);
+    slot->entry.fieldEngine = new FieldEngine(maze);
+    slot->entry.overlay = -1;
+    MazeGraphic* mazeGraphic = slot->entry.truth->getMazeGraphic();
+    for (int x = 0; x < maze->getWidth(); x += 1) {
+        for (int y = 0; y < maze->getHeight(); y += 1) {
+            for (Direction d : DIRECTIONS()) {
+                if (maze->isWall(x, y, d)) {
+                    mazeGraphic->setWall(x, y, d);
+                }
+            }
+        }
+    }
+    stat(slot);
+    slot->bytes = getBytes(slot->entry);
+    m_slots.prepend(slot);
+    m_bytes += slot->bytes;
+    return &slot->entry;
+}
+
+void MazeCache::trim() {
+    for (int i = m_slots.size() - 1; 0 < i; i -= 1) {
+        Slot* slot = m_slots.at(i);
+        if (slot->isStale) {
+            m_slots.removeAt(i);
+            m_bytes -= slot->bytes;
+            deleteSlot(slot);
+        }
+    }
+    while (1 < m_slots.size() && MAX_BYTES < m_bytes) {
+        Slot* slot = m_slots.takeLast();
+        m_bytes -= slot->bytes;
+        deleteSlot(slot);
+    }
+}
+
+QList<MazeCache::Entry*> MazeCache::getEntries() {
+    QList<Entry*> entries;
+    for (Slot* slot : m_slots) {
+        entries.append(&slot->entry);
+    }
+    return entries;
+}
+
+void MazeCache::stat(Slot* slot) {
+
+    // Generated mazes have no file, and never change
+    QString file = slot->path;
+    if (!QFileInfo(file).isFile()) {
+        file = MazeCorpus::getFile(file);
+    }
+    QFileInfo info(file);
+    slot->lastModified = info.lastModified();
+    slot->fileSize = info.size();
+}
+
+void MazeCache::deleteSlot(Slot* slot) {
+    delete slot->entry.fieldEngine;
+    delete slot->entry.belief;
+    delete slot->entry.truth;
+    delete slot->entry.maze;
+    delete slot;
+}
+
+qint64 MazeCache::getBytes(const Entry& entry) {
+    qint64 cells = entry.maze->getWidth() * entry.maze->getHeight();
+    const WallGrid& walls = entry.maze->getWalls();
+    qint64 bytes =
+        cells * (sizeof(int) + sizeof(quint16)) +
+        sizeof(quint64) * (
+            walls.getHorizontalWalls().size() +
+            walls.getVerticalWalls().size()) +
+        sizeof(int) * cells * FIELDS().size();
+    for (const MazeView* view : {entry.truth, entry.belief}) {
+        bytes +=
+            sizeof(TriangleGraphic) * view->getGraphicCpuBuffer()->capacity() +
+            sizeof(TriangleTexture) * view->getTextureCpuBuffer()->capacity();
+    }
+    return bytes;
+}
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+#include "FieldEngine.h"
+#include "Maze.h"
+#include "MazeView.h"
+
+namespace mms {
+
+// Keeps recently shown mazes, along with their views and fields, so that
+// switching back to one doesn't have to parse the file, triangulate every
+// tile, or recompute any fields. Entries are keyed by path and are
+// dropped once the file has been modified; the least recently used ones are
+// deleted once the entries take up more than MAX_BYTES.
+class MazeCache {
+
+public:
+
+    struct Entry {
+        Maze* maze;
+        MazeView* truth; // with every wall declared
+        MazeView* belief; // untouched, copied by each mouse that runs
+        FieldEngine* fieldEngine;
+        int overlay; // the field shown as text by the truth, or -1 if none
+    };
+
+    MazeCache();
+    ~MazeCache();
+
+    // Returns nullptr unless the path is cached and its file hasn't changed
+    // since; the entry becomes the most recently used one
+    Entry* get(const QString& path);
+
+    // Takes ownership of the maze, builds its views and fields, and
+    // returns its entry, which becomes the most recently used one
+    Entry* insert(const QString& path, Maze* maze);
+
+    // Deletes stale entries, then least recently used entries until the rest
+    // fit, but never the most recently used one, which is presumably being
+    // shown; see get()
+    void trim();
+
+    QList<Entry*> getEntries();
+
+    static const qint64 MAX_BYTES;
+
+private:
+
+    struct Slot {
+        QString path;
+        QDateTime lastModified;
+        qint64 fileSize;
+        qint64 bytes;
+        bool isStale; // the file changed while the entry was being shown
+        Entry entry;
+    };
+
+    // Most recently used first
+    QList<Slot*> m_slots;
+    qint64 m_bytes;
+
+    // Fills in the modification time and size of the file behind the path,
+    // which is a corpus for references into one (see MazeCorpus)
+    static void stat(Slot* slot);
+    static void deleteSlot(Slot* slot);
+
+    // Roughly how much memory an entry uses
+    static qint64 getBytes(const Entry& entry);
+};
+
+}
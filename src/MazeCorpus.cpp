@@ -0,0 +1,356 @@
+#include "MazeCorpus.h"
+
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QVector>
+#include <QtEndian>
+
+#include <climits>
+#include <cstring>
+
+#include "AssertMacros.h"
+#include "FieldEngine.h"
+#include "MazeHash.h"
+
+namespace mms {
+
+const QString MazeCorpus::EXTENSION = ".mzc";
+
+const QByteArray MazeCorpus::MAGIC = "MMSMAZES";
+const quint32 MazeCorpus::VERSION = 1;
+const int MazeCorpus::HEADER_SIZE = 16;
+const int MazeCorpus::ENTRY_SIZE = 56;
+
+// Offsets of the fields within the header and within each index entry
+static const int HEADER_MAGIC = 0;
+static const int HEADER_VERSION = 8;
+static const int HEADER_COUNT = 12;
+static const int ENTRY_WALLS_OFFSET = 0;
+static const int ENTRY_NAME_OFFSET = 8;
+static const int ENTRY_HASH = 16;
+static const int ENTRY_NAME_SIZE = 24;
+static const int ENTRY_WIDTH = 28;
+static const int ENTRY_HEIGHT = 32;
+static const int ENTRY_OPTIMAL_SCORE = 36;
+static const int ENTRY_SHORTEST_PATH = 40;
+static const int ENTRY_MAX_DISTANCE = 44;
+static const int ENTRY_UNREACHABLE_CELLS = 48;
+
+MazeCorpus* MazeCorpus::open(const QString& path) {
+
+    // Resources can't be mapped, so corpora must be regular files
+    MazeCorpus* corpus = new MazeCorpus(path);
+    if (!corpus->m_file.open(QFile::ReadOnly)) {
+        delete corpus;
+        return nullptr;
+    }
+    corpus->m_size = corpus->m_file.size();
+    if (corpus->m_size < HEADER_SIZE) {
+        delete corpus;
+        return nullptr;
+    }
+    corpus->m_data = corpus->m_file.map(0, corpus->m_size);
+    if (corpus->m_data == nullptr) {
+        delete corpus;
+        return nullptr;
+    }
+
+    // Check the header, then the index
+    const uchar* data = corpus->m_data;
+    quint32 version = qFromLittleEndian<quint32>(data + HEADER_VERSION);
+    quint32 count = qFromLittleEndian<quint32>(data + HEADER_COUNT);
+    if (
+        std::memcmp(data + HEADER_MAGIC, MAGIC.constData(), MAGIC.size()) ||
+        version != VERSION ||
+        INT_MAX < count ||
+        (corpus->m_size - HEADER_SIZE) / ENTRY_SIZE < count
+    ) {
+        delete corpus;
+        return nullptr;
+    }
+    corpus->m_count = count;
+    if (!corpus->isWellFormed()) {
+        delete corpus;
+        return nullptr;
+    }
+    return corpus;
+}
+
+bool MazeCorpus::write(
+        const QString& path, const QMap<QString, WallGrid>& mazes) {
+
+    // The index comes first, then the names, then the walls, which are
+    // aligned so that each word can be read in place
+    QVector<QByteArray> names;
+    qint64 size = HEADER_SIZE + mazes.size() * ENTRY_SIZE;
+    for (const QString& name : mazes.keys()) {
+        if (name.isEmpty()) {
+            return false;
+        }
+        names.append(name.toUtf8());
+        size += names.last().size();
+    }
+    size = (size + 7) / 8 * 8;
+    for (const WallGrid& walls : mazes.values()) {
+        size += 8 * (
+            walls.getHorizontalWalls().size() +
+            walls.getVerticalWalls().size());
+    }
+    if (INT_MAX < size) {
+        return false;
+    }
+
+    QByteArray bytes(static_cast<int>(size), 0);
+    uchar* data = reinterpret_cast<uchar*>(bytes.data());
+    std::memcpy(data + HEADER_MAGIC, MAGIC.constData(), MAGIC.size());
+    qToLittleEndian<quint32>(VERSION, data + HEADER_VERSION);
+    qToLittleEndian<quint32>(mazes.size(), data + HEADER_COUNT);
+
+    qint64 nameOffset = HEADER_SIZE + mazes.size() * ENTRY_SIZE;
+    qint64 wallsOffset = nameOffset;
+    for (const QByteArray& name : names) {
+        wallsOffset += name.size();
+    }
+    wallsOffset = (wallsOffset + 7) / 8 * 8;
+
+    int index = 0;
+    for (auto it = mazes.constBegin(); it != mazes.constEnd(); ++it) {
+        const WallGrid& walls = it.value();
+        const QByteArray& name = names.at(index);
+
+        // The stats are what a caller would otherwise need a FieldEngine for
+        Maze* maze = Maze::fromWalls(walls);
+        if (maze == nullptr) {
+            return false;
+        }
+        FieldEngine fieldEngine(maze);
+        float optimalScore = fieldEngine.getOptimalScore();
+        int maxDistance = -1;
+        int unreachableCells = 0;
+        for (int x = 0; x < maze->getWidth(); x += 1) {
+            for (int y = 0; y < maze->getHeight(); y += 1) {
+                int distance = maze->getDistance(x, y);
+                if (distance == -1) {
+                    unreachableCells += 1;
+                }
+                maxDistance = qMax(maxDistance, distance);
+            }
+        }
+        quint32 optimalBits = 0;
+        std::memcpy(&optimalBits, &optimalScore, sizeof(optimalBits));
+
+        uchar* entry = data + HEADER_SIZE + index * ENTRY_SIZE;
+        qToLittleEndian<quint64>(wallsOffset, entry + ENTRY_WALLS_OFFSET);
+        qToLittleEndian<quint64>(nameOffset, entry + ENTRY_NAME_OFFSET);
+        qToLittleEndian<quint64>(
+            MazeHash::getHash(walls), entry + ENTRY_HASH);
+        qToLittleEndian<quint32>(name.size(), entry + ENTRY_NAME_SIZE);
+        qToLittleEndian<quint32>(walls.getWidth(), entry + ENTRY_WIDTH);
+        qToLittleEndian<quint32>(walls.getHeight(), entry + ENTRY_HEIGHT);
+        qToLittleEndian<quint32>(optimalBits, entry + ENTRY_OPTIMAL_SCORE);
+        qToLittleEndian<qint32>(
+            maze->getDistance(0, 0), entry + ENTRY_SHORTEST_PATH);
+        qToLittleEndian<qint32>(maxDistance, entry + ENTRY_MAX_DISTANCE);
+        qToLittleEndian<qint32>(
+            unreachableCells, entry + ENTRY_UNREACHABLE_CELLS);
+        delete maze;
+
+        std::memcpy(data + nameOffset, name.constData(), name.size());
+        nameOffset += name.size();
+        for (const QVector<quint64>* plane : {
+            &walls.getHorizontalWalls(),
+            &walls.getVerticalWalls(),
+        }) {
+            for (quint64 word : *plane) {
+                qToLittleEndian<quint64>(word, data + wallsOffset);
+                wallsOffset += 8;
+            }
+        }
+        index += 1;
+    }
+
+    // Write to a temporary file first, so that a failed write doesn't
+    // clobber an existing corpus
+    QSaveFile file(path);
+    if (!file.open(QFile::WriteOnly)) {
+        return false;
+    }
+    if (file.write(bytes) != bytes.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+QString MazeCorpus::getPath() const {
+    return m_path;
+}
+
+int MazeCorpus::getCount() const {
+    return m_count;
+}
+
+MazeCorpus::Entry MazeCorpus::getEntry(int index) const {
+    const uchar* entry = getEntryData(index);
+    quint32 optimalBits =
+        qFromLittleEndian<quint32>(entry + ENTRY_OPTIMAL_SCORE);
+    Entry result;
+    result.name = getName(index);
+    result.width = qFromLittleEndian<quint32>(entry + ENTRY_WIDTH);
+    result.height = qFromLittleEndian<quint32>(entry + ENTRY_HEIGHT);
+    result.hash = qFromLittleEndian<quint64>(entry + ENTRY_HASH);
+    std::memcpy(&result.optimalScore, &optimalBits, sizeof(optimalBits));
+    result.shortestPath =
+        qFromLittleEndian<qint32>(entry + ENTRY_SHORTEST_PATH);
+    result.maxDistance = qFromLittleEndian<qint32>(entry + ENTRY_MAX_DISTANCE);
+    result.unreachableCells =
+        qFromLittleEndian<qint32>(entry + ENTRY_UNREACHABLE_CELLS);
+    return result;
+}
+
+int MazeCorpus::find(const QString& name) const {
+
+    // Entries are sorted by name, see write()
+    int low = 0;
+    int high = m_count;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (getName(middle) < name) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    if (low < m_count && getName(low) == name) {
+        return low;
+    }
+    return -1;
+}
+
+WallGrid MazeCorpus::getWalls(int index) const {
+    const uchar* entry = getEntryData(index);
+    int width = qFromLittleEndian<quint32>(entry + ENTRY_WIDTH);
+    int height = qFromLittleEndian<quint32>(entry + ENTRY_HEIGHT);
+    const uchar* words =
+        m_data + qFromLittleEndian<quint64>(entry + ENTRY_WALLS_OFFSET);
+    QVector<quint64> horizontal(
+        WallGrid::getHorizontalWordCount(width, height));
+    QVector<quint64> vertical(WallGrid::getVerticalWordCount(width, height));
+    for (int i = 0; i < horizontal.size(); i += 1) {
+        horizontal[i] = qFromLittleEndian<quint64>(words + 8 * i);
+    }
+    words += 8 * horizontal.size();
+    for (int i = 0; i < vertical.size(); i += 1) {
+        vertical[i] = qFromLittleEndian<quint64>(words + 8 * i);
+    }
+    return WallGrid(width, height, horizontal, vertical);
+}
+
+Maze* MazeCorpus::getMaze(int index) const {
+    return Maze::fromWalls(getWalls(index));
+}
+
+QString MazeCorpus::getReference(const QString& path, const QString& name) {
+    return path + "#" + name;
+}
+
+Maze* MazeCorpus::fromReference(const QString& reference) {
+
+    // Either the path or the name could contain a '#', so try every split
+    // until the path is a corpus
+    int split = reference.indexOf('#');
+    while (split != -1) {
+        MazeCorpus* corpus = open(reference.left(split));
+        if (corpus != nullptr) {
+            int index = corpus->find(reference.mid(split + 1));
+            Maze* maze = index == -1 ? nullptr : corpus->getMaze(index);
+            delete corpus;
+            return maze;
+        }
+        split = reference.indexOf('#', split + 1);
+    }
+    return nullptr;
+}
+
+QString MazeCorpus::getFile(const QString& reference) {
+    int split = reference.indexOf('#');
+    while (split != -1) {
+        if (QFileInfo(reference.left(split)).isFile()) {
+            return reference.left(split);
+        }
+        split = reference.indexOf('#', split + 1);
+    }
+    return QString();
+}
+
+QStringList MazeCorpus::findMazeFiles(const QString& directory) {
+    QStringList paths;
+    QDirIterator it(
+        directory,
+        {"*.map", "*.num", "*.maz"},
+        QDir::Files,
+        QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        paths.append(it.next());
+    }
+    paths.sort();
+    return paths;
+}
+
+MazeCorpus::MazeCorpus(const QString& path) :
+    m_path(path),
+    m_file(path),
+    m_data(nullptr),
+    m_size(0),
+    m_count(0) {
+}
+
+bool MazeCorpus::isWellFormed() const {
+    for (int index = 0; index < m_count; index += 1) {
+        const uchar* entry = getEntryData(index);
+        quint64 wallsOffset =
+            qFromLittleEndian<quint64>(entry + ENTRY_WALLS_OFFSET);
+        quint64 nameOffset =
+            qFromLittleEndian<quint64>(entry + ENTRY_NAME_OFFSET);
+        quint64 nameSize = qFromLittleEndian<quint32>(entry + ENTRY_NAME_SIZE);
+        quint64 width = qFromLittleEndian<quint32>(entry + ENTRY_WIDTH);
+        quint64 height = qFromLittleEndian<quint32>(entry + ENTRY_HEIGHT);
+        quint64 size = m_size;
+
+        // The dimensions must be small enough that the bit counts of the
+        // planes fit in an int, see WallGrid::getHorizontalWordCount()
+        if (width == 0 || height == 0 || INT_MAX < (width + 1) * height ||
+                INT_MAX < width * (height + 1)) {
+            return false;
+        }
+        quint64 words =
+            WallGrid::getHorizontalWordCount(width, height) +
+            WallGrid::getVerticalWordCount(width, height);
+        if (size < nameOffset || size - nameOffset < nameSize) {
+            return false;
+        }
+        if (wallsOffset % 8 != 0 || size < wallsOffset ||
+                (size - wallsOffset) / 8 < words) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const uchar* MazeCorpus::getEntryData(int index) const {
+    ASSERT_LE(0, index);
+    ASSERT_LT(index, m_count);
+    return m_data + HEADER_SIZE + index * ENTRY_SIZE;
+}
+
+QString MazeCorpus::getName(int index) const {
+    const uchar* entry = getEntryData(index);
+    return QString::fromUtf8(
+        reinterpret_cast<const char*>(
+            m_data + qFromLittleEndian<quint64>(entry + ENTRY_NAME_OFFSET)),
+        qFromLittleEndian<quint32>(entry + ENTRY_NAME_SIZE));
+}
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include "Maze.h"
+#include "WallGrid.h"
+
+namespace mms {
+
+// A single file holding many mazes, so that large collections load without
+// parsing anything. The file is memory mapped and stays mapped while the
+// corpus is open; the index (names, dimensions, hashes, and stats) can be
+// read without touching any walls, and walls are only copied out of the
+// mapping when a maze is requested. See the README for the format.
+class MazeCorpus {
+
+public:
+
+    struct Entry {
+        QString name;
+        int width;
+        int height;
+        quint64 hash; // see MazeHash::getHash()
+        float optimalScore; // -1 if the center can't be reached
+        int shortestPath; // from the start to the center, -1 if unreachable
+        int maxDistance; // to the center, over the cells that can reach it
+        int unreachableCells; // cells that can't reach the center
+    };
+
+    // Returns nullptr unless the file is a well formed corpus
+    static MazeCorpus* open(const QString& path);
+
+    // Writes the mazes in order of name; returns false if a name is empty, a
+    // maze isn't enclosed, the corpus would exceed 2 GB, or the file couldn't
+    // be written
+    static bool write(
+        const QString& path, const QMap<QString, WallGrid>& mazes);
+
+    QString getPath() const;
+    int getCount() const;
+    Entry getEntry(int index) const;
+    int find(const QString& name) const; // -1 if there's no such maze
+    WallGrid getWalls(int index) const;
+    Maze* getMaze(int index) const;
+
+    // Mazes within a corpus are referred to as "<corpus path>#<name>", e.g.,
+    // in the list of maze files. Returns nullptr if there's no such maze.
+    static QString getReference(const QString& path, const QString& name);
+    static Maze* fromReference(const QString& reference);
+
+    // The file that a reference refers into, or an empty string if there's
+    // no such file, e.g., to tell when the maze may have changed
+    static QString getFile(const QString& reference);
+
+    // All .map, .num, and .maz files under the directory, sorted
+    static QStringList findMazeFiles(const QString& directory);
+
+    static const QString EXTENSION;
+
+private:
+
+    // Layout of the file, see the README
+    static const QByteArray MAGIC;
+    static const quint32 VERSION;
+    static const int HEADER_SIZE;
+    static const int ENTRY_SIZE;
+
+    QString m_path;
+    QFile m_file;
+    const uchar* m_data;
+    qint64 m_size;
+    int m_count;
+
+    explicit MazeCorpus(const QString& path);
+
+    // Checks that every entry lies within the file
+    bool isWellFormed() const;
+
+    const uchar* getEntryData(int index) const;
+    QString getName(int index) const;
+};
+
+}
@@ -0,0 +1,572 @@
+#include "MazeGenerator.h"
+
+#include <QPair>
+#include <QThread>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "AssertMacros.h"
+#include "Maze.h"
+
+namespace mms {
+
+const QVector<MazeAlgorithm>& MAZE_ALGORITHMS() {
+    static const QVector<MazeAlgorithm> vector = {
+        MazeAlgorithm::TOMASZ,
+        MazeAlgorithm::RANDOMIZE,
+    };
+    return vector;
+}
+
+const QMap<MazeAlgorithm, QString>& MAZE_ALGORITHM_TO_STRING() {
+    static const QMap<MazeAlgorithm, QString> map = {
+        {MazeAlgorithm::TOMASZ, "Tomasz"},
+        {MazeAlgorithm::RANDOMIZE, "Randomize"},
+    };
+    return map;
+}
+
+const double MazeGenerator::STRAIGHT_FACTOR = 0.85;
+const double MazeGenerator::DEAD_END_BREAK_CHANCE = 0.75;
+const int MazeGenerator::DEAD_END_BREAK_THRESHOLD = 8;
+const int MazeGenerator::GRADIENT_WALL_BREAKS = 3;
+const double MazeGenerator::WALL_PROBABILITY = 0.40;
+
+// Directions are numbered like DIRECTIONS()
+static const int DX[] = {0, 1, 0, -1};
+static const int DY[] = {1, 0, -1, 0};
+static const int NORTH = static_cast<int>(Direction::NORTH);
+static const int EAST = static_cast<int>(Direction::EAST);
+static const int SOUTH = static_cast<int>(Direction::SOUTH);
+static const int WEST = static_cast<int>(Direction::WEST);
+
+MazeGenerator::MazeGenerator(MazeAlgorithm algorithm, int width, int height) :
+    m_algorithm(algorithm),
+    m_width(width),
+    m_height(height),
+    m_walls(width, height),
+    m_random(0),
+    m_wallMasks(width * height, 0),
+    m_edgeMasks(width * height, 0),
+    m_isCenter(width * height, false),
+    m_isExplored(width * height, false),
+    m_parents(width * height, -1),
+    m_depths(width * height, 0),
+    m_sourceDistances(width * height, -1),
+    m_distances(width * height, -1),
+    m_stamps(width * height, 0),
+    m_queue(width * height, 0),
+    m_stamp(0) {
+
+    ASSERT_LE(1, width);
+    ASSERT_LE(1, height);
+
+    // The center must not cut the start off from the rest of the maze
+    if (algorithm == MazeAlgorithm::TOMASZ) {
+        ASSERT_LE(3, width);
+        ASSERT_LE(3, height);
+    }
+    for (QPair<int, int> center : Maze::getCenterPositions(width, height)) {
+        m_isCenter[center.first * height + center.second] = true;
+        m_centers.append(center.first * height + center.second);
+    }
+    m_stack.reserve(width * height);
+    for (int direction = 0; direction < 4; direction += 1) {
+        m_offsets[direction] = DX[direction] * height + DY[direction];
+    }
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            for (int direction = 0; direction < 4; direction += 1) {
+                int nx = x + DX[direction];
+                int ny = y + DY[direction];
+                if (nx < 0 || ny < 0 || width <= nx || height <= ny) {
+                    m_edgeMasks[x * height + y] |= 1 << direction;
+                }
+            }
+        }
+    }
+
+    // Every maze of the Tomasz algorithm starts with every wall up, except
+    // for those inside of the center
+    for (int cell = 0; cell < width * height; cell += 1) {
+        for (int direction = 0; direction < 4; direction += 1) {
+            int neighbor = getNeighbor(cell, direction);
+            bool isOpen = (
+                neighbor != -1 &&
+                m_isCenter.at(cell) &&
+                m_isCenter.at(neighbor)
+            );
+            setWall(cell, direction, !isOpen);
+        }
+    }
+    m_closedWalls = m_walls;
+    m_closedWallMasks = m_wallMasks;
+}
+
+WallGrid MazeGenerator::generate(quint64 seed) {
+
+    // SplitMix64 advances its state by an odd constant, so distinct seeds
+    // (e.g., consecutive ones) yield unrelated streams of random numbers
+    m_random = seed;
+    m_stamps.fill(0);
+    m_stamp = 0;
+
+    switch (m_algorithm) {
+        case MazeAlgorithm::TOMASZ:
+            generateTomasz();
+            return m_walls;
+        case MazeAlgorithm::RANDOMIZE:
+            generateRandomize();
+            return m_walls;
+    }
+    ASSERT_NEVER_RUNS();
+}
+
+QVector<WallGrid> MazeGenerator::generateMany(
+        MazeAlgorithm algorithm,
+        int width,
+        int height,
+        quint64 seed,
+        int count,
+        int threads) {
+
+    ASSERT_LE(0, count);
+    if (threads <= 0) {
+        threads = QThread::idealThreadCount();
+    }
+    threads = qBound(1, threads, qMax(count, 1));
+
+    // Each thread gets its own generator and a contiguous range of mazes.
+    // The generators are created up front, so that invalid dimensions fail
+    // here rather than on a worker thread.
+    std::vector<MazeGenerator> generators;
+    generators.reserve(threads);
+    for (int i = 0; i < threads; i += 1) {
+        generators.emplace_back(algorithm, width, height);
+    }
+    QVector<WallGrid> mazes(count);
+    WallGrid* data = mazes.data();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i += 1) {
+        MazeGenerator* generator = &generators[i];
+        int begin = static_cast<int>(qint64(count) * i / threads);
+        int end = static_cast<int>(qint64(count) * (i + 1) / threads);
+        workers.emplace_back([=](){
+            for (int j = begin; j < end; j += 1) {
+                data[j] = generator->generate(seed + j);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return mazes;
+}
+
+void MazeGenerator::generateTomasz() {
+
+    // Copy rather than assign, so that the masks don't share (and later
+    // reallocate) the closed ones
+    m_walls.copyWalls(m_closedWalls);
+    std::copy(
+        m_closedWallMasks.constBegin(),
+        m_closedWallMasks.constEnd(),
+        m_wallMasks.begin());
+
+    // Depth first search from the start, which never enters the center
+    m_isExplored.fill(false);
+    m_isExplored[0] = true;
+    m_parents[0] = -1;
+    m_depths[0] = 0;
+    m_stack.clear();
+    m_stack.append(0);
+    m_loops.clear();
+    int lastDirection = -1;
+    while (!m_stack.isEmpty()) {
+        int cell = m_stack.last();
+        bool choices[4];
+        int possible = 0;
+        for (int direction = 0; direction < 4; direction += 1) {
+            int neighbor = getNeighbor(cell, direction);
+            choices[direction] = (
+                neighbor != -1 &&
+                !m_isExplored.at(neighbor) &&
+                !m_isCenter.at(neighbor)
+            );
+            if (choices[direction]) {
+                possible += 1;
+            }
+        }
+
+        // If the cell is a dead end that we just moved into, maybe break the
+        // wall to the neighbor that's farthest away by path, which results
+        // in more open mazes. Then backtrack.
+        if (possible == 0) {
+            m_stack.removeLast();
+            if (lastDirection != -1 && getRandom() <= DEAD_END_BREAK_CHANCE) {
+                int targets[4];
+                int count = 0;
+                for (int direction = 0; direction < 4; direction += 1) {
+                    if (isExploredNeighbor(cell, direction)) {
+                        targets[count] = getNeighbor(cell, direction);
+                        count += 1;
+                    }
+                }
+                updateDistances(cell, targets, count);
+                if (breakGradientWall(cell, DEAD_END_BREAK_THRESHOLD)) {
+                    m_loops.append(cell);
+                }
+            }
+            lastDirection = -1;
+            continue;
+        }
+
+        // The chance of continuing straight is proportional to how far the
+        // cell is from the center, so the maze turns more near the center
+        int x = cell / m_height;
+        int y = cell % m_height;
+        double xCenterDistance =
+            qAbs(x - m_width / 2.0) * 2.0 / (m_width - 1);
+        double yCenterDistance =
+            qAbs(y - m_height / 2.0) * 2.0 / (m_height - 1);
+        double moveConst =
+            STRAIGHT_FACTOR * qMax(xCenterDistance, yCenterDistance);
+
+        int direction = getDirectionToMove(choices, lastDirection, moveConst);
+        int neighbor = getNeighbor(cell, direction);
+        setWall(cell, direction, false);
+        m_isExplored[neighbor] = true;
+        m_parents[neighbor] = cell;
+        m_depths[neighbor] = m_depths.at(cell) + 1;
+        m_stack.append(neighbor);
+        lastDirection = direction;
+    }
+
+    breakGradientWalls();
+    pathIntoCenter();
+}
+
+void MazeGenerator::generateRandomize() {
+
+    // Every interior wall exists with the same probability; retry until the
+    // center can be reached, so that the maze is valid
+    m_walls.fill(false);
+    m_wallMasks.fill(0);
+    do {
+        for (int x = 0; x < m_width; x += 1) {
+            for (int y = 0; y < m_height; y += 1) {
+                int cell = x * m_height + y;
+                bool south = y == 0 || getRandom() <= WALL_PROBABILITY;
+                bool west = x == 0 || getRandom() <= WALL_PROBABILITY;
+                setWall(cell, SOUTH, south);
+                setWall(cell, WEST, west);
+                if (y == m_height - 1) {
+                    setWall(cell, NORTH, true);
+                }
+                if (x == m_width - 1) {
+                    setWall(cell, EAST, true);
+                }
+            }
+        }
+    } while (!isCenterReachable());
+}
+
+quint64 MazeGenerator::getRandomBits() {
+    // SplitMix64
+    m_random += Q_UINT64_C(0x9E3779B97F4A7C15);
+    quint64 z = m_random;
+    z = (z ^ (z >> 30)) * Q_UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * Q_UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+double MazeGenerator::getRandom() {
+    // The top 53 bits, scaled into [0, 1)
+    return (getRandomBits() >> 11) * (1.0 / (Q_UINT64_C(1) << 53));
+}
+
+int MazeGenerator::getRandomInt(int bound) {
+    // The top 32 bits, scaled into [0, bound)
+    return static_cast<int>(((getRandomBits() >> 32) * bound) >> 32);
+}
+
+int MazeGenerator::getDirectionToMove(
+        const bool* choices, int lastDirection, double moveConst) {
+
+    int possible = 0;
+    for (int direction = 0; direction < 4; direction += 1) {
+        if (choices[direction]) {
+            possible += 1;
+        }
+    }
+
+    // If the last move can be repeated and isn't the only option, repeat it
+    // with probability moveConst, and otherwise take any other option
+    int excluded = -1;
+    if (lastDirection != -1 && choices[lastDirection] && possible != 1) {
+        if (getRandom() <= moveConst) {
+            return lastDirection;
+        }
+        excluded = lastDirection;
+        possible -= 1;
+    }
+
+    int index = getRandomInt(possible);
+    for (int direction = 0; direction < 4; direction += 1) {
+        if (!choices[direction] || direction == excluded) {
+            continue;
+        }
+        if (index == 0) {
+            return direction;
+        }
+        index -= 1;
+    }
+    ASSERT_NEVER_RUNS();
+}
+
+void MazeGenerator::breakGradientWalls() {
+
+    // The walls that may be broken, each measured from the cell to its
+    // north or east (directions 0 and 1) and identified by cell * 2 plus
+    // the direction, along with the distance by path across them. The maze
+    // is the search tree plus the walls broken at dead ends, so a shortest
+    // path either stays within the tree or goes through one of those walls,
+    // and searching from one side of each of them is enough.
+    m_candidates.clear();
+    m_gradients.clear();
+    for (int cell = 1; cell < m_width * m_height; cell += 1) {
+        if (m_isCenter.at(cell)) {
+            continue;
+        }
+        for (int direction : {NORTH, EAST}) {
+            if (!isExploredNeighbor(cell, direction)) {
+                continue;
+            }
+            if (isWall(cell, direction)) {
+                int neighbor = getNeighbor(cell, direction);
+                m_candidates.append(cell * 2 + direction);
+                m_gradients.append(getTreeDistance(cell, neighbor));
+            }
+        }
+    }
+    const int* candidates = m_candidates.constData();
+    int* gradients = m_gradients.data();
+    int count = m_candidates.size();
+    const int* distances = m_distances.constData();
+    for (int loop : m_loops) {
+        updateDistances(loop, nullptr, 0);
+        for (int i = 0; i < count; i += 1) {
+            int cell = candidates[i] / 2;
+            int neighbor = cell + m_offsets[candidates[i] % 2];
+            gradients[i] = qMin(
+                gradients[i], distances[cell] + distances[neighbor]);
+        }
+    }
+
+    // Break the wall across which the distance is greatest, a few times
+    for (int round = 0; round < GRADIENT_WALL_BREAKS; round += 1) {
+        int greatest = -1;
+        for (int i = 0; i < count; i += 1) {
+            if (greatest == -1 || gradients[greatest] < gradients[i]) {
+                greatest = i;
+            }
+        }
+
+        // If nothing is broken, the next rounds wouldn't break anything
+        if (greatest == -1 ||
+                gradients[greatest] <= DEAD_END_BREAK_THRESHOLD) {
+            return;
+        }
+
+        // The new path can only shorten the distances across other walls,
+        // which are updated with the distances from both of its ends
+        int from = candidates[greatest] / 2;
+        int direction = candidates[greatest] % 2;
+        int to = from + m_offsets[direction];
+        updateDistances(from, nullptr, 0);
+        int* fromDistances = m_sourceDistances.data();
+        for (int cell = 0; cell < m_width * m_height; cell += 1) {
+            fromDistances[cell] = distances[cell];
+        }
+        updateDistances(to, nullptr, 0);
+        for (int i = 0; i < count; i += 1) {
+            int cell = candidates[i] / 2;
+            int neighbor = cell + m_offsets[candidates[i] % 2];
+            int forward = fromDistances[cell] + 1 + distances[neighbor];
+            int backward = distances[cell] + 1 + fromDistances[neighbor];
+            gradients[i] = qMin(gradients[i], qMin(forward, backward));
+        }
+        setWall(from, direction, false);
+    }
+}
+
+bool MazeGenerator::breakGradientWall(int cell, int threshold) {
+
+    // Break the wall to the neighbor whose distance differs the most from
+    // the cell's, according to the most recent search
+    int current = getDistance(cell);
+    int biggestDifference = 0;
+    int directionToBreak = -1;
+    for (int direction = 0; direction < 4; direction += 1) {
+        if (!isExploredNeighbor(cell, direction)) {
+            continue;
+        }
+        int difference =
+            qAbs(getDistance(getNeighbor(cell, direction)) - current);
+        if (biggestDifference < difference) {
+            biggestDifference = difference;
+            directionToBreak = direction;
+        }
+    }
+    if (threshold < biggestDifference) {
+        setWall(cell, directionToBreak, false);
+        return true;
+    }
+    return false;
+}
+
+void MazeGenerator::pathIntoCenter() {
+
+    // Like the original, the entrance goes into whichever of the other
+    // center cells has the neighbor that's farthest from the start, or into
+    // the first center cell if there are no others. Unlike the original,
+    // the wall is always broken, so the center can always be reached.
+    updateDistances(0, nullptr, 0);
+    QVector<QPair<int, int>> centers =
+        Maze::getCenterPositions(m_width, m_height);
+    int entrance = centers.first().first * m_height + centers.first().second;
+    int greatestGradient = 0;
+    for (int i = 1; i < centers.size(); i += 1) {
+        int cell = centers.at(i).first * m_height + centers.at(i).second;
+        int current = getDistance(cell);
+        for (int direction = 0; direction < 4; direction += 1) {
+            if (!isExploredNeighbor(cell, direction)) {
+                continue;
+            }
+            int gradient =
+                qAbs(getDistance(getNeighbor(cell, direction)) - current);
+            if (greatestGradient < gradient) {
+                greatestGradient = gradient;
+                entrance = cell;
+            }
+        }
+    }
+    breakGradientWall(entrance, 0);
+}
+
+bool MazeGenerator::isExploredNeighbor(int cell, int direction) const {
+    int neighbor = getNeighbor(cell, direction);
+    return (
+        neighbor > 0 &&
+        m_isExplored.at(neighbor) &&
+        !m_isCenter.at(neighbor)
+    );
+}
+
+void MazeGenerator::updateDistances(
+        int source, const int* targets, int count) {
+
+    // The maze is enclosed the whole time, so open walls never lead off of
+    // the grid and neighbors can be found by offset alone
+    m_stamp += 1;
+    int stamp = m_stamp;
+    int offsets[4] = {m_offsets[0], m_offsets[1], m_offsets[2], m_offsets[3]};
+    const quint8* wallMasks = m_wallMasks.constData();
+    int* distances = m_distances.data();
+    int* stamps = m_stamps.data();
+    int* queue = m_queue.data();
+    distances[source] = 0;
+    stamps[source] = stamp;
+    queue[0] = source;
+    int head = 0;
+    int tail = 1;
+    int remaining = count;
+    while (head < tail) {
+        int cell = queue[head];
+        head += 1;
+        quint8 mask = wallMasks[cell];
+        for (int direction = 0; direction < 4; direction += 1) {
+            if ((mask >> direction) & 1) {
+                continue;
+            }
+            int neighbor = cell + offsets[direction];
+            if (stamps[neighbor] == stamp) {
+                continue;
+            }
+            distances[neighbor] = distances[cell] + 1;
+            stamps[neighbor] = stamp;
+            queue[tail] = neighbor;
+            tail += 1;
+            for (int i = 0; i < count; i += 1) {
+                if (targets[i] == neighbor) {
+                    remaining -= 1;
+                }
+            }
+            if (0 < count && remaining == 0) {
+                return;
+            }
+        }
+    }
+}
+
+int MazeGenerator::getTreeDistance(int a, int b) const {
+    int distance = 0;
+    while (a != b) {
+        if (m_depths.at(a) < m_depths.at(b)) {
+            qSwap(a, b);
+        }
+        a = m_parents.at(a);
+        distance += 1;
+    }
+    return distance;
+}
+
+int MazeGenerator::getDistance(int cell) const {
+    if (m_stamps.at(cell) != m_stamp) {
+        return -1;
+    }
+    return m_distances.at(cell);
+}
+
+int MazeGenerator::getNeighbor(int cell, int direction) const {
+    if ((m_edgeMasks.at(cell) >> direction) & 1) {
+        return -1;
+    }
+    return cell + m_offsets[direction];
+}
+
+bool MazeGenerator::isWall(int cell, int direction) const {
+    return (m_wallMasks.at(cell) >> direction) & 1;
+}
+
+void MazeGenerator::setWall(int cell, int direction, bool isWall) {
+
+    // Update both sides of the wall, and the wall itself
+    int neighbor = getNeighbor(cell, direction);
+    int opposite = (direction + 2) % 4;
+    quint8 bit = 1 << direction;
+    m_wallMasks[cell] = isWall ?
+        (m_wallMasks.at(cell) | bit) : (m_wallMasks.at(cell) & ~bit);
+    if (neighbor != -1) {
+        bit = 1 << opposite;
+        m_wallMasks[neighbor] = isWall ?
+            (m_wallMasks.at(neighbor) | bit) :
+            (m_wallMasks.at(neighbor) & ~bit);
+    }
+    m_walls.setWall(
+        cell / m_height, cell % m_height, DIRECTIONS().at(direction), isWall);
+}
+
+bool MazeGenerator::isCenterReachable() {
+    updateDistances(0, m_centers.constData(), m_centers.size());
+    for (int center : m_centers) {
+        if (getDistance(center) != -1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+#include "WallGrid.h"
+
+namespace mms {
+
+enum class MazeAlgorithm {
+    TOMASZ,
+    RANDOMIZE,
+};
+
+// A convenient way to enumerate through all of the maze algorithms
+const QVector<MazeAlgorithm>& MAZE_ALGORITHMS();
+
+const QMap<MazeAlgorithm, QString>& MAZE_ALGORITHM_TO_STRING();
+
+// Generates mazes directly into a WallGrid. Every maze is enclosed and its
+// center can be reached from the start, i.e., it passes Maze::isValid(), and
+// the same algorithm, dimensions, and seed always yield the same maze.
+//
+// A generator keeps its scratch space between mazes and writes each maze over
+// the previous one in place, so generating many mazes with one generator
+// only allocates the walls of the mazes that are returned. generateMany()
+// runs one generator per thread, and the threads share nothing else.
+class MazeGenerator {
+
+public:
+
+    MazeGenerator(MazeAlgorithm algorithm, int width, int height);
+
+    WallGrid generate(quint64 seed);
+
+    // Maze i is generate(seed + i), so the mazes don't depend on the number
+    // of threads; zero threads means QThread::idealThreadCount()
+    static QVector<WallGrid> generateMany(
+        MazeAlgorithm algorithm,
+        int width,
+        int height,
+        quint64 seed,
+        int count,
+        int threads = 0);
+
+    // Parameters of the Tomasz algorithm, ported from the old simulator
+    static const double STRAIGHT_FACTOR;
+    static const double DEAD_END_BREAK_CHANCE;
+    static const int DEAD_END_BREAK_THRESHOLD;
+    static const int GRADIENT_WALL_BREAKS;
+
+    // Parameters of the Randomize algorithm
+    static const double WALL_PROBABILITY;
+
+private:
+
+    MazeAlgorithm m_algorithm;
+    int m_width;
+    int m_height;
+    WallGrid m_walls;
+    WallGrid m_closedWalls;
+    quint64 m_random;
+
+    // Cell data is stored as flat arrays, indexed by x * height + y. The
+    // walls of each cell are also kept as a mask, in the format of
+    // WallGrid::getWallMask(), since the searches read them constantly.
+    QVector<quint8> m_wallMasks;
+    QVector<quint8> m_edgeMasks; // bit set if there's no neighbor that way
+    QVector<quint8> m_closedWallMasks;
+    QVector<bool> m_isCenter;
+    QVector<int> m_centers;
+    QVector<bool> m_isExplored;
+    QVector<int> m_stack;
+
+    // The tree built by the depth first search, and the cells whose walls
+    // were broken at dead ends, each of which closes a loop in the tree
+    QVector<int> m_parents;
+    QVector<int> m_depths;
+    QVector<int> m_loops;
+
+    // See breakGradientWalls()
+    QVector<int> m_candidates;
+    QVector<int> m_gradients;
+    QVector<int> m_sourceDistances;
+
+    // Distances from the most recent search are only valid for cells whose
+    // stamp matches the current one, which saves clearing them every time
+    QVector<int> m_distances;
+    QVector<int> m_stamps;
+    QVector<int> m_queue;
+    int m_stamp;
+
+    // The difference in index between a cell and its neighbor in each
+    // direction, which is only safe to use across open walls
+    int m_offsets[4];
+
+    void generateTomasz();
+    void generateRandomize();
+
+    // Random numbers, see generate() for how the state is seeded
+    quint64 getRandomBits();
+    double getRandom();
+    int getRandomInt(int bound);
+
+    // The Tomasz algorithm: a depth first search that prefers to go straight
+    // far from the center and to turn near it, with walls broken between
+    // cells that are far apart by path, so that the maze has loops
+    int getDirectionToMove(
+        const bool* choices, int lastDirection, double moveConst);
+    void breakGradientWalls();
+    bool breakGradientWall(int cell, int threshold);
+    void pathIntoCenter();
+
+    // Whether the neighbor has been explored and is neither the start nor
+    // in the center, i.e., whether the wall between them may be broken
+    bool isExploredNeighbor(int cell, int direction) const;
+
+    // A breadth first search from the cell, which stops early once every
+    // target has been reached; targets may be nullptr if count is zero
+    void updateDistances(int source, const int* targets, int count);
+    int getDistance(int cell) const;
+    int getTreeDistance(int a, int b) const;
+
+    // The neighboring cell in direction DIRECTIONS().at(direction), or -1
+    int getNeighbor(int cell, int direction) const;
+    bool isWall(int cell, int direction) const;
+    void setWall(int cell, int direction, bool isWall);
+    bool isCenterReachable();
+};
+
+}
@@ -1,18 +1,30 @@
 #include "MazeGraphic.h"
 
+#include <QThread>
+#include <QtGlobal>
+
+#include <thread>
+#include <vector>
+
 #include "AssertMacros.h"
 
 namespace mms {
 
+const int MazeGraphic::MIN_TILES_PER_THREAD = 1024;
+
 MazeGraphic::MazeGraphic(
         const Maze* maze,
         BufferInterface* bufferInterface,
-        bool isTruthView) {
+        bool isTruthView) :
+        m_bufferInterface(bufferInterface),
+        m_threadCount(0) {
     for (int x = 0; x < maze->getWidth(); x += 1) {
         QVector<TileGraphic> column;
         for (int y = 0; y < maze->getHeight(); y += 1) {
             column.append(TileGraphic(
-                maze->getTile(x, y),
+                maze,
+                x,
+                y,
                 bufferInterface,
                 isTruthView));
         }
@@ -20,6 +32,21 @@ MazeGraphic::MazeGraphic(
     }
 }
 
+MazeGraphic::MazeGraphic(
+        const MazeGraphic& other,
+        BufferInterface* bufferInterface) :
+        m_bufferInterface(bufferInterface),
+        m_threadCount(other.m_threadCount),
+        m_pendingTiles(other.m_pendingTiles) {
+    for (const QVector<TileGraphic>& otherColumn : other.m_tileGraphics) {
+        QVector<TileGraphic> column;
+        for (const TileGraphic& tileGraphic : otherColumn) {
+            column.append(TileGraphic(tileGraphic, bufferInterface));
+        }
+        m_tileGraphics.append(column);
+    }
+}
+
 void MazeGraphic::setWall(int x, int y, Direction direction) {
     m_tileGraphics[x][y].setWall(direction);
 }
@@ -29,37 +56,61 @@ void MazeGraphic::clearWall(int x, int y, Direction direction) {
 }
 
 void MazeGraphic::setColor(int x, int y, Color color) {
+    bool wasPending = m_tileGraphics.at(x).at(y).hasPendingUpdates();
     m_tileGraphics[x][y].setColor(color);
+    markPending(x, y, wasPending);
 }
 
 void MazeGraphic::clearColor(int x, int y) {
+    bool wasPending = m_tileGraphics.at(x).at(y).hasPendingUpdates();
     m_tileGraphics[x][y].clearColor();
+    markPending(x, y, wasPending);
+}
+
+void MazeGraphic::clearAllColor() {
+    // Tiles without a color are skipped by TileGraphic, so this is a
+    // single pass that only queues the tiles that actually change
+    for (int x = 0; x < m_tileGraphics.size(); x += 1) {
+        for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
+            clearColor(x, y);
+        }
+    }
 }
 
 void MazeGraphic::setText(int x, int y, const QString& text) {
+    bool wasPending = m_tileGraphics.at(x).at(y).hasPendingUpdates();
     m_tileGraphics[x][y].setText(text);
+    markPending(x, y, wasPending);
 }
 
 void MazeGraphic::clearText(int x, int y) {
+    bool wasPending = m_tileGraphics.at(x).at(y).hasPendingUpdates();
     m_tileGraphics[x][y].clearText();
+    markPending(x, y, wasPending);
 }
 
-void MazeGraphic::drawPolygons() const {
-    // Fill the GRAPHIC_CPU_BUFFER
+void MazeGraphic::clearAllText() {
     for (int x = 0; x < m_tileGraphics.size(); x += 1) {
         for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
-            m_tileGraphics.at(x).at(y).drawPolygons();
+            clearText(x, y);
         }
     }
 }
 
+void MazeGraphic::drawPolygons() const {
+    // Fill the GRAPHIC_CPU_BUFFER
+    m_bufferInterface->initGraphicCpuBuffer();
+    forEachTile([](const TileGraphic& tileGraphic){
+        tileGraphic.drawPolygons();
+    });
+}
+
 void MazeGraphic::drawTextures() const {
     // Fill the TEXTURE_CPU_BUFFER
-    for (int x = 0; x < m_tileGraphics.size(); x += 1) {
-        for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
-            m_tileGraphics[x][y].drawTextures();
-        }
-    }
+    m_bufferInterface->initTextureCpuBuffer();
+    forEachTile([](const TileGraphic& tileGraphic){
+        tileGraphic.drawTextures();
+    });
 }
 
 void MazeGraphic::refreshColors() {
@@ -70,4 +121,57 @@ void MazeGraphic::refreshColors() {
     }
 }
 
+void MazeGraphic::flushUpdates() {
+    for (const QPair<int, int>& position : m_pendingTiles) {
+        m_tileGraphics[position.first][position.second].flushUpdates();
+    }
+    m_pendingTiles.clear();
+}
+
+void MazeGraphic::setThreadCount(int threadCount) {
+    ASSERT_LE(0, threadCount);
+    m_threadCount = threadCount;
+}
+
+void MazeGraphic::markPending(int x, int y, bool wasPending) {
+    if (!wasPending && m_tileGraphics.at(x).at(y).hasPendingUpdates()) {
+        m_pendingTiles.append({x, y});
+    }
+}
+
+void MazeGraphic::forEachTile(
+        const std::function<void(const TileGraphic&)>& function) const {
+    int width = m_tileGraphics.size();
+    int height = width == 0 ? 0 : m_tileGraphics.at(0).size();
+    int threads = m_threadCount;
+    if (threads == 0) {
+        threads = qBound(
+            1,
+            width * height / MIN_TILES_PER_THREAD,
+            QThread::idealThreadCount());
+    }
+    threads = qBound(1, threads, qMax(width, 1));
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i += 1) {
+        int begin = width * i / threads;
+        int end = width * (i + 1) / threads;
+        auto work = [=, &function](){
+            for (int x = begin; x < end; x += 1) {
+                for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
+                    function(m_tileGraphics.at(x).at(y));
+                }
+            }
+        };
+        if (threads == 1) {
+            work();
+        }
+        else {
+            workers.emplace_back(work);
+        }
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
 } 
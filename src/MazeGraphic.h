@@ -1,7 +1,10 @@
 #pragma once
 
+#include <QPair>
 #include <QVector>
 
+#include <functional>
+
 #include "BufferInterface.h"
 #include "Color.h"
 #include "Maze.h"
@@ -18,23 +21,51 @@ public:
         BufferInterface* bufferInterface,
         bool isTruthView);
 
+    // A copy of another graphic, which updates the given buffers instead
+    MazeGraphic(const MazeGraphic& other, BufferInterface* bufferInterface);
+
     void setWall(int x, int y, Direction direction);
     void clearWall(int x, int y, Direction direction);
 
     void setColor(int x, int y, Color color);
     void clearColor(int x, int y);
+    void clearAllColor();
 
     void setText(int x, int y, const QString& text);
     void clearText(int x, int y);
+    void clearAllText();
 
     void drawPolygons() const;
     void drawTextures() const;
 
     void refreshColors();
 
+    // Writes the color and text of every tile that has changed since the
+    // last flush to the buffers; call this once per frame, before drawing
+    void flushUpdates();
+
+    // The number of threads that the tiles are drawn on, or 0 to choose one
+    // from the size of the maze and the number of cores
+    void setThreadCount(int threadCount);
+
 private:
 
+    // Mazes with fewer tiles than this are drawn on a single thread
+    static const int MIN_TILES_PER_THREAD;
+
+    BufferInterface* m_bufferInterface;
     QVector<QVector<TileGraphic>> m_tileGraphics;
+    int m_threadCount;
+
+    // The tiles with updates that haven't been flushed, each listed once
+    QVector<QPair<int, int>> m_pendingTiles;
+    void markPending(int x, int y, bool wasPending);
+
+    // Calls the function for every tile, split into ranges of columns that
+    // are handled on separate threads, since each tile only touches its own
+    // part of the buffers
+    void forEachTile(
+        const std::function<void(const TileGraphic&)>& function) const;
 
 };
 
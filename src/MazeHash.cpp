@@ -0,0 +1,222 @@
+#include "MazeHash.h"
+
+#include "AssertMacros.h"
+
+namespace mms {
+
+quint64 MazeHash::getHash(const WallGrid& walls) {
+    return getHash(
+        walls.getWidth(),
+        walls.getHeight(),
+        walls.getHorizontalWalls(),
+        walls.getVerticalWalls());
+}
+
+quint64 MazeHash::getCanonicalHash(
+        const WallGrid& walls, Symmetry* symmetry) {
+    QVector<Symmetry> symmetries;
+    quint64 hash = getCanonicalHash(walls, &symmetries);
+    if (symmetry != nullptr) {
+        *symmetry = symmetries.first();
+    }
+    return hash;
+}
+
+quint64 MazeHash::getStartHash(const WallGrid& walls, Symmetry orientation) {
+
+    // The start of the oriented maze is the corner of the maze that the
+    // orientation sends to (0, 0). For symmetric mazes, several symmetries
+    // yield the canonical orientation, so use the least corner that any of
+    // them sends the start to.
+    QVector<Symmetry> symmetries;
+    quint64 hash = getCanonicalHash(walls, &symmetries);
+    int corner = 3;
+    for (Symmetry symmetry : symmetries) {
+        bool farX = SYMMETRY_MIRRORS_X().value(orientation);
+        bool farY = SYMMETRY_MIRRORS_Y().value(orientation);
+        farX ^= SYMMETRY_MIRRORS_X().value(symmetry);
+        farY ^= SYMMETRY_MIRRORS_Y().value(symmetry);
+        if (SYMMETRY_SWAPS_AXES().value(symmetry)) {
+            qSwap(farX, farY);
+        }
+        corner = qMin(corner, (farX ? 1 : 0) + (farY ? 2 : 0));
+    }
+
+    // Mix the corner into the hash the same way getHash() mixes in bytes
+    hash ^= corner;
+    hash *= Q_UINT64_C(1099511628211);
+    return hash;
+}
+
+quint64 MazeHash::getCanonicalHash(
+        const WallGrid& walls, QVector<Symmetry>* symmetries) {
+
+    // Keep the least orientation seen so far, and write each of the others
+    // into scratch planes that are swapped in whenever they're less
+    int bestWidth = walls.getWidth();
+    int bestHeight = walls.getHeight();
+    QVector<quint64> bestHorizontal = walls.getHorizontalWalls();
+    QVector<quint64> bestVertical = walls.getVerticalWalls();
+    symmetries->append(Symmetry::IDENTITY);
+
+    int width = 0;
+    int height = 0;
+    QVector<quint64> horizontal;
+    QVector<quint64> vertical;
+    for (Symmetry symmetry : SYMMETRIES()) {
+        if (symmetry == Symmetry::IDENTITY) {
+            continue;
+        }
+        transform(walls, symmetry, &width, &height, &horizontal, &vertical);
+        if (
+            width == bestWidth &&
+            height == bestHeight &&
+            horizontal == bestHorizontal &&
+            vertical == bestVertical
+        ) {
+            symmetries->append(symmetry);
+            continue;
+        }
+        bool isLess =
+            width != bestWidth ? width < bestWidth :
+            height != bestHeight ? height < bestHeight :
+            horizontal != bestHorizontal ? horizontal < bestHorizontal :
+            vertical < bestVertical;
+        if (!isLess) {
+            continue;
+        }
+        bestWidth = width;
+        bestHeight = height;
+        bestHorizontal.swap(horizontal);
+        bestVertical.swap(vertical);
+        symmetries->clear();
+        symmetries->append(symmetry);
+    }
+    return getHash(bestWidth, bestHeight, bestHorizontal, bestVertical);
+}
+
+quint64 MazeHash::getHash(
+        int width,
+        int height,
+        const QVector<quint64>& horizontal,
+        const QVector<quint64>& vertical) {
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    auto update = [&](quint64 value, int bytes) {
+        for (int i = 0; i < bytes; i += 1) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= Q_UINT64_C(1099511628211);
+        }
+    };
+    update(width, 4);
+    update(height, 4);
+    for (quint64 word : horizontal) {
+        update(word, 8);
+    }
+    for (quint64 word : vertical) {
+        update(word, 8);
+    }
+    return hash;
+}
+
+void MazeHash::transform(
+        const WallGrid& walls,
+        Symmetry symmetry,
+        int* width,
+        int* height,
+        QVector<quint64>* horizontal,
+        QVector<quint64>* vertical) {
+
+    // Mirroring x reverses the bits of each horizontal row and the order of
+    // the vertical columns, and vice versa for y. Swapping the axes makes
+    // the rows columns and the columns rows, i.e., swaps the planes, since
+    // both store their walls in the same order.
+    int w = walls.getWidth();
+    int h = walls.getHeight();
+    bool mirrorX = SYMMETRY_MIRRORS_X().value(symmetry);
+    bool mirrorY = SYMMETRY_MIRRORS_Y().value(symmetry);
+    bool swapAxes = SYMMETRY_SWAPS_AXES().value(symmetry);
+    *width = swapAxes ? h : w;
+    *height = swapAxes ? w : h;
+    horizontal->fill(0, WallGrid::getHorizontalWordCount(*width, *height));
+    vertical->fill(0, WallGrid::getVerticalWordCount(*width, *height));
+    QVector<quint64>* rows = swapAxes ? vertical : horizontal;
+    QVector<quint64>* columns = swapAxes ? horizontal : vertical;
+    copyRows(
+        walls.getHorizontalWalls().constData(),
+        rows->data(),
+        h + 1,
+        w,
+        mirrorY,
+        mirrorX);
+    copyRows(
+        walls.getVerticalWalls().constData(),
+        columns->data(),
+        w + 1,
+        h,
+        mirrorX,
+        mirrorY);
+}
+
+void MazeHash::copyRows(
+        const quint64* source,
+        quint64* destination,
+        int count,
+        int length,
+        bool flip,
+        bool reverse) {
+    int index = 0;
+    for (int row = 0; row < count; row += 1) {
+        int start = (flip ? count - 1 - row : row) * length;
+        for (int offset = 0; offset < length; offset += 64) {
+            int size = qMin(64, length - offset);
+            quint64 bits = 0;
+            if (reverse) {
+                bits = getBits(source, start + length - offset - size, size);
+                bits = reverseBits(bits) >> (64 - size);
+            }
+            else {
+                bits = getBits(source, start + offset, size);
+            }
+            orBits(destination, index, size, bits);
+            index += size;
+        }
+    }
+}
+
+quint64 MazeHash::getBits(const quint64* plane, int index, int length) {
+    int word = index / 64;
+    int offset = index % 64;
+    quint64 bits = plane[word] >> offset;
+    if (64 < offset + length) {
+        bits |= plane[word + 1] << (64 - offset);
+    }
+    if (length < 64) {
+        bits &= (Q_UINT64_C(1) << length) - 1;
+    }
+    return bits;
+}
+
+void MazeHash::orBits(quint64* plane, int index, int length, quint64 bits) {
+    int word = index / 64;
+    int offset = index % 64;
+    plane[word] |= bits << offset;
+    if (64 < offset + length) {
+        plane[word + 1] |= bits >> (64 - offset);
+    }
+}
+
+quint64 MazeHash::reverseBits(quint64 bits) {
+    bits = ((bits >> 1) & Q_UINT64_C(0x5555555555555555)) |
+        ((bits & Q_UINT64_C(0x5555555555555555)) << 1);
+    bits = ((bits >> 2) & Q_UINT64_C(0x3333333333333333)) |
+        ((bits & Q_UINT64_C(0x3333333333333333)) << 2);
+    bits = ((bits >> 4) & Q_UINT64_C(0x0f0f0f0f0f0f0f0f)) |
+        ((bits & Q_UINT64_C(0x0f0f0f0f0f0f0f0f)) << 4);
+    bits = ((bits >> 8) & Q_UINT64_C(0x00ff00ff00ff00ff)) |
+        ((bits & Q_UINT64_C(0x00ff00ff00ff00ff)) << 8);
+    bits = ((bits >> 16) & Q_UINT64_C(0x0000ffff0000ffff)) |
+        ((bits & Q_UINT64_C(0x0000ffff0000ffff)) << 16);
+    return (bits >> 32) | (bits << 32);
+}
+
+}
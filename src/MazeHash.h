@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "Symmetry.h"
+#include "WallGrid.h"
+
+namespace mms {
+
+// Content hashes of mazes, which are cheap enough to compute on every load
+class MazeHash {
+
+public:
+    MazeHash() = delete;
+
+    // FNV-1a over the dimensions and the bit planes of the walls
+    static quint64 getHash(const WallGrid& walls);
+
+    // The hash of the canonical orientation of the maze, i.e., the least of
+    // its eight symmetries when ordered by dimensions and then by the words
+    // of its bit planes, so that rotated and mirrored copies of a maze all
+    // hash the same. The symmetry that yields the canonical orientation is
+    // optionally returned; for symmetric mazes, it's the first one.
+    static quint64 getCanonicalHash(
+        const WallGrid& walls, Symmetry* symmetry = nullptr);
+
+    // Like the canonical hash, but also distinguishes the corner that the
+    // start ends up in. The mouse always starts at (0, 0), which only the
+    // identity and the transpose leave in place, so mazes with equal start
+    // hashes have the same shortest paths, optimal scores, etc., and can
+    // share cached results. The orientation hashes the maze as if it were
+    // rotated or mirrored by it first, see OrientedMaze.
+    static quint64 getStartHash(
+        const WallGrid& walls, Symmetry orientation = Symmetry::IDENTITY);
+
+private:
+
+    // Also returns every symmetry that yields the canonical orientation
+    static quint64 getCanonicalHash(
+        const WallGrid& walls, QVector<Symmetry>* symmetries);
+
+    static quint64 getHash(
+        int width,
+        int height,
+        const QVector<quint64>& horizontal,
+        const QVector<quint64>& vertical);
+
+    // Writes the walls as transformed by the symmetry into the planes,
+    // which are resized and cleared first
+    static void transform(
+        const WallGrid& walls,
+        Symmetry symmetry,
+        int* width,
+        int* height,
+        QVector<quint64>* horizontal,
+        QVector<quint64>* vertical);
+
+    // Copies count rows of length bits each, where row i of the destination
+    // is row i of the source (or count - 1 - i, if flipped), with its bits
+    // in reverse order if reversed
+    static void copyRows(
+        const quint64* source,
+        quint64* destination,
+        int count,
+        int length,
+        bool flip,
+        bool reverse);
+
+    // At most 64 bits at an arbitrary index of a plane
+    static quint64 getBits(const quint64* plane, int index, int length);
+    static void orBits(quint64* plane, int index, int length, quint64 bits);
+    static quint64 reverseBits(quint64 bits);
+};
+
+}
@@ -15,12 +15,20 @@ MazeView::MazeView(
             &m_textureCpuBuffer),
         m_mazeGraphic(maze, &m_bufferInterface, isTruthView) {
 
-    // Establish the coordinates for the tile text characters
+    // Populate the data vectors with wall polygons and, after establishing
+    // the coordinates for the tile text characters, tile distance text
+    m_mazeGraphic.drawPolygons();
     initText(2, 5);
+}
 
-    // Populate the data vectors with wall polygons and tile distance text.
-    m_mazeGraphic.drawPolygons();
-    m_mazeGraphic.drawTextures();
+MazeView::MazeView(const MazeView& other) :
+        m_graphicCpuBuffer(other.m_graphicCpuBuffer),
+        m_textureCpuBuffer(other.m_textureCpuBuffer),
+        m_bufferInterface(
+            other.m_bufferInterface,
+            &m_graphicCpuBuffer,
+            &m_textureCpuBuffer),
+        m_mazeGraphic(other.m_mazeGraphic, &m_bufferInterface) {
 }
 
 MazeGraphic* MazeView::getMazeGraphic() {
@@ -31,6 +39,10 @@ void MazeView::initTileGraphicText(int numRows, int numCols) {
     initText(numRows, numCols);
 }
 
+void MazeView::flushUpdates() {
+    m_mazeGraphic.flushUpdates();
+}
+
 const QVector<TriangleGraphic>* MazeView::getGraphicCpuBuffer() const {
     return &m_graphicCpuBuffer;
 }
@@ -15,8 +15,20 @@ class MazeView {
 public:
 
     MazeView(const Maze* maze, bool isTruthView);
+
+    // Copies the other view without drawing anything; the buffers are shared
+    // until either view changes, e.g., so that every run can start from the
+    // same untouched view of the maze
+    MazeView(const MazeView& other);
+    MazeView& operator=(const MazeView& other) = delete;
+
     MazeGraphic* getMazeGraphic();
     void initTileGraphicText(int numRows, int numCols);
+
+    // Brings the buffers up to date with the MazeGraphic, see
+    // MazeGraphic::flushUpdates(); called by the Map before each frame
+    void flushUpdates();
+
     const QVector<TriangleGraphic>* getGraphicCpuBuffer() const;
     const QVector<TriangleTexture>* getTextureCpuBuffer() const;
 
@@ -5,8 +5,9 @@
 
 namespace mms {
 
-MouseGraphic::MouseGraphic(const Mouse* mouse) :
-    m_mouse(mouse) {
+MouseGraphic::MouseGraphic(const Mouse* mouse, int index) :
+    m_mouse(mouse),
+    m_index(index) {
 }
 
 QVector<TriangleGraphic> MouseGraphic::draw() const {
@@ -18,10 +19,26 @@ QVector<TriangleGraphic> MouseGraphic::draw() const {
     ));
     buffer.append(SimUtilities::polygonToTriangleGraphics(
         m_mouse->getCurrentBodyPolygon(),
-        ColorManager::get()->getMouseBodyColor(),
+        getBodyColor(),
         255
     ));
     return buffer;
 }
 
+Color MouseGraphic::getBodyColor() const {
+    static const QVector<Color> raceColors = {
+        Color::BLUE,
+        Color::GREEN,
+        Color::ORANGE,
+        Color::CYAN,
+        Color::YELLOW,
+        Color::DARK_VIOLET,
+        Color::WHITE,
+    };
+    if (m_index == 0) {
+        return ColorManager::get()->getMouseBodyColor();
+    }
+    return raceColors.at((m_index - 1) % raceColors.size());
+}
+
 } 
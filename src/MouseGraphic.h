@@ -2,6 +2,7 @@
 
 #include <QVector>
 
+#include "Color.h"
 #include "Mouse.h"
 #include "TriangleGraphic.h"
 
@@ -10,11 +11,16 @@ namespace mms {
 class MouseGraphic {
 
 public:
-    MouseGraphic(const Mouse* mouse);
+    // The first mouse uses the configured body color, any additional
+    // racing mice are drawn in distinct colors so they can be told apart
+    MouseGraphic(const Mouse* mouse, int index = 0);
     QVector<TriangleGraphic> draw() const;
 
 private:
     const Mouse* m_mouse;
+    int m_index;
+
+    Color getBodyColor() const;
 
 };
 
@@ -0,0 +1,1259 @@
+#include "MouseSession.h"
+
+#include <QRegExp>
+#include <QtMath>
+
+#include "AssertMacros.h"
+#include "Dimensions.h"
+#include "FontImage.h"
+#include "ProcessUtilities.h"
+
+namespace mms {
+
+const QString MouseSession::ACK = "ack";
+const QString MouseSession::CRASH = "crash";
+const QString MouseSession::INVALID = "invalid";
+const QString MouseSession::RESET = "reset";
+
+const int MouseSession::MAX_COMMANDS_PER_SLICE = 256;
+const int MouseSession::MAX_QUEUED_COMMANDS = 1024;
+const qint64 MouseSession::MAX_BUFFERED_BYTES = 32 * 1024 * 1024;
+const int MouseSession::MAX_BATCHED_COMMANDS = 1024;
+const int MouseSession::USAGE_SAMPLE_INTERVAL_MS = 50;
+
+const double MouseSession::PROGRESS_REQUIRED_FOR_MOVE = 100.0;
+const double MouseSession::PROGRESS_REQUIRED_FOR_TURN = 33.33;
+const double MouseSession::MIN_PROGRESS_PER_SECOND = 10.0;
+const double MouseSession::MAX_PROGRESS_PER_SECOND = 5000.0;
+const double MouseSession::MAX_SLEEP_SECONDS = 0.008;
+
+MouseSession::MouseSession(
+        const Maze* maze,
+        const MazeView* view,
+        Stats* stats,
+        LogConsole* runOutput,
+        const QSlider* speedSlider,
+        int index) :
+    m_maze(maze),
+    m_stats(stats),
+    m_runOutput(runOutput),
+    m_speedSlider(speedSlider),
+
+    // Owned state
+    m_process(nullptr),
+    m_mouse(new Mouse()),
+    m_view(new MazeView(*view)),
+    m_mouseGraphic(new MouseGraphic(m_mouse, index)),
+    m_exitedNormally(false),
+
+    // Pause/reset
+    m_isPaused(false),
+    m_wasReset(false),
+
+    // Communication
+    m_logBuffer(QStringList()),
+    m_wasFlooded(false),
+    m_commandQueue(RingBuffer<SerialCommand>(MAX_QUEUED_COMMANDS)),
+    m_commandQueueTimer(new QTimer(this)),
+    m_queueClock(QElapsedTimer()),
+    m_lastQueueTime(0),
+    m_usageTimer(new QTimer(this)),
+    m_hasUsage(false),
+    m_usage({0.0, 0.0, -1}),
+    m_senseOnArrival(false),
+    m_resetEvents(false),
+    m_isBatching(false),
+    m_batch(QVector<DrawCommand>()),
+
+    // Movement
+    m_startingLocation({0, 0}),
+    m_startingDirection(Direction::NORTH),
+    m_movement(Movement::NONE),
+    m_doomedToCrash(false),
+    m_movesRemaining(0),
+    m_movementProgress(0.0),
+    m_movementStepSize(0.0),
+    m_pathIndex(-1) {
+
+    // Configure the usage timer
+    m_usageTimer->setInterval(USAGE_SAMPLE_INTERVAL_MS);
+    connect(m_usageTimer, &QTimer::timeout, this, [=](){
+        sampleUsage();
+    });
+
+    // Configure command queue timer
+    m_queueClock.start();
+    m_commandQueueTimer->setSingleShot(true);
+    connect(
+        m_commandQueueTimer,
+        &QTimer::timeout,
+        this,
+        &MouseSession::processCommands
+    );
+}
+
+MouseSession::~MouseSession() {
+    // NOTE: The process must be canceled before the session is destroyed
+    delete m_mouseGraphic;
+    delete m_view;
+    delete m_mouse;
+}
+
+bool MouseSession::start(const QString& runCommand, const QString& directory) {
+
+    // Only one process per session
+    ASSERT_TR(m_process == nullptr);
+
+    // Instantiate a new process
+    QProcess* process = new QProcess();
+
+    // Print stderr
+    connect(process, &QProcess::readyReadStandardError, this, [=](){
+        QString output = process->readAllStandardError();
+        QStringList logs = processText(output, &m_logBuffer);
+        for (QString log : logs) {
+            m_runOutput->appendLine(log);
+        }
+    });
+
+    // Process commands from stdout, unless processing is already scheduled;
+    // the output stays in the process's buffer until it's dispatched
+    connect(process, &QProcess::readyReadStandardOutput, this, [=](){
+        checkBufferedBytes();
+        if (!m_commandQueueTimer->isActive()) {
+            processCommands();
+        }
+    });
+
+    // Take a last sample once stdout closes, which happens as the process
+    // exits: QProcess reaps the process before emitting finished(), after
+    // which it's gone from /proc, so a short run might otherwise go unsampled
+    connect(process, &QProcess::readChannelFinished, this, [=](){
+        sampleUsage();
+    });
+
+    // Clean up on exit
+    connect(
+        process,
+        static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+            &QProcess::finished
+        ),
+        this,
+        &MouseSession::onProcessExit
+    );
+
+    // Start the run process
+    if (!ProcessUtilities::start(runCommand, directory, process)) {
+        m_runOutput->appendLine(process->errorString());
+        delete process;
+        return false;
+    }
+    m_process = process;
+    m_wasFlooded = false;
+    m_hasUsage = false;
+    m_usage = {0.0, 0.0, -1};
+    m_usageTimer->start();
+    return true;
+}
+
+void MouseSession::cancel() {
+    if (m_process == nullptr) {
+        return;
+    }
+    m_process->kill();
+    m_process->waitForFinished();
+}
+
+bool MouseSession::isRunning() const {
+    return m_process != nullptr;
+}
+
+bool MouseSession::exitedNormally() const {
+    return m_exitedNormally;
+}
+
+MazeView* MouseSession::getView() const {
+    return m_view;
+}
+
+const MouseGraphic* MouseSession::getMouseGraphic() const {
+    return m_mouseGraphic;
+}
+
+void MouseSession::setPaused(bool paused) {
+    m_isPaused = paused;
+    if (!m_isPaused && isRunning() && !m_commandQueueTimer->isActive()) {
+        processCommands();
+    }
+}
+
+void MouseSession::requestReset() {
+    m_wasReset = true;
+    // Algorithms that enabled reset events are told right away, so they never
+    // have to poll wasReset; the event may arrive ahead of any response
+    if (m_resetEvents && isRunning()) {
+        m_process->write((RESET + "\n").toStdString().c_str());
+    }
+}
+
+bool MouseSession::isWaitingForReset() const {
+    return m_wasReset;
+}
+
+void MouseSession::onProcessExit(int exitCode, QProcess::ExitStatus exitStatus) {
+
+    m_exitedNormally = (exitStatus == QProcess::NormalExit && exitCode == 0);
+    m_isPaused = false;
+    m_wasReset = false;
+
+    // Clean up (stop producing commands)
+    delete m_process;
+    m_process = nullptr;
+
+    // Report the resources used by the run, as of the last sample
+    m_usageTimer->stop();
+    if (m_hasUsage) {
+        QString perMove = m_stats->getStat(StatsEnum::CPU_TIME_PER_MOVE);
+        QString peakMemory = m_stats->getStat(StatsEnum::PEAK_MEMORY);
+        m_runOutput->appendLine(
+            QString("CPU time: %1 ms user, %2 ms system (%3 ms per move), "
+                    "peak memory: %4 MB")
+                .arg(m_stats->getStat(StatsEnum::CPU_USER_TIME))
+                .arg(m_stats->getStat(StatsEnum::CPU_SYSTEM_TIME))
+                .arg(perMove.isEmpty() ? "-" : perMove)
+                .arg(peakMemory.isEmpty() ? "-" : peakMemory));
+    }
+
+    // Stop consuming queued commands
+    m_commandQueueTimer->stop();
+    m_commandQueue.clear();
+    updateQueueMetrics();
+    m_isBatching = false;
+    m_batch.clear();
+    m_path.clear();
+
+    emit exited();
+}
+
+void MouseSession::sampleUsage() {
+    if (m_process == nullptr) {
+        return;
+    }
+    // Keep the last good sample if the process is already gone
+    ProcessUsage usage;
+    if (!ProcessUtilities::getUsage(m_process->processId(), &usage)) {
+        return;
+    }
+    // An exited process has released its memory, so its peak is the one from
+    // the last sample, if any; its CPU time is still exact
+    if (usage.peakResidentKilobytes == -1) {
+        usage.peakResidentKilobytes = m_usage.peakResidentKilobytes;
+    }
+    m_usage = usage;
+    m_hasUsage = true;
+    m_stats->setProcessUsage(
+        m_usage.userMilliseconds,
+        m_usage.systemMilliseconds,
+        m_usage.peakResidentKilobytes == -1
+            ? -1
+            : m_usage.peakResidentKilobytes / 1024.0);
+}
+
+void MouseSession::updateQueueMetrics() {
+    m_stats->setQueueMetrics(m_commandQueue.size(), m_lastQueueTime);
+}
+
+QStringList MouseSession::processText(QString text, QStringList* buffer) {
+
+    QStringList lines;
+
+    // Separate the text by line
+    text.replace("\r", "");  // Windows compatibility
+    QStringList parts = text.split("\n");
+
+    // If the text has at least one newline character, we definitely have a
+    // complete line; combine it with the contents of the buffer and append
+    // it to the list of lines to be returned
+    if (1 < parts.size()) {
+        lines.append(buffer->join("") + parts.at(0));
+        buffer->clear();
+    }
+
+    // All newline-separated parts in the text are lines
+    for (int i = 1; i < parts.size() - 1; i += 1) {
+        lines.append(parts.at(i));
+    }
+
+    // Store the last part of the text (empty string if the text ended
+    // with newline) in the buffer, to be combined with future input
+    buffer->append(parts.at(parts.size() - 1));
+
+    return lines;
+}
+
+void MouseSession::dispatchCommand(QString command) {
+
+    // Hold the no-response commands of a batch until it's complete, and then
+    // apply them all at once - the maze isn't redrawn in the meantime
+    if (command == "beginBatch") {
+        m_isBatching = true;
+        return;
+    }
+    if (command == "endBatch") {
+        m_isBatching = false;
+        applyBatch();
+        return;
+    }
+
+    // For performance reasons, handle no-response commands inline (don't queue
+    // them with the commands that elicit a response, just perform the action)
+    DrawCommand draw;
+    if (parseDrawCommand(command, &draw)) {
+        if (!m_isBatching) {
+            executeDrawCommand(draw);
+            return;
+        }
+        m_batch.append(draw);
+        if (m_batch.size() == MAX_BATCHED_COMMANDS) {
+            applyBatch();
+        }
+        return;
+    }
+
+    // Enqueue the serial command, it's executed by processCommands(); drop
+    // invalid commands on the floor
+    SerialCommand parsed;
+    if (parseCommand(command, &parsed)) {
+        parsed.queuedAt = m_queueClock.elapsed();
+        m_commandQueue.enqueue(parsed);
+    }
+}
+
+void MouseSession::applyBatch() {
+    for (const DrawCommand& command : m_batch) {
+        executeDrawCommand(command);
+    }
+    m_batch.clear();
+}
+
+bool MouseSession::parseDrawCommand(QString command, DrawCommand* parsed) const {
+    QString function = command.left(command.indexOf(" "));
+    parsed->x = 0;
+    parsed->y = 0;
+    parsed->x2 = 0;
+    parsed->y2 = 0;
+    parsed->width = 0;
+    parsed->value = QChar();
+    parsed->text = QStringList();
+    if (function == "setText") {
+        // Special parsing to allow space characters in the text
+        int firstSpace = command.indexOf(" ");
+        int secondSpace = command.indexOf(" ", firstSpace + 1);
+        int thirdSpace = command.indexOf(" ", secondSpace + 1);
+        QString xString = command.mid(firstSpace + 1, secondSpace - firstSpace);
+        QString yString = command.mid(secondSpace + 1, thirdSpace - secondSpace);
+        bool xOk = true;
+        bool yOk = true;
+        parsed->x = xString.toInt(&xOk);
+        parsed->y = yString.toInt(&yOk);
+        if (!xOk || !yOk) {
+            return false;
+        }
+        parsed->function = DrawFunction::SET_TEXT;
+        parsed->text = QStringList(command.mid(thirdSpace + 1));
+        return true;
+    }
+
+    // The rest of the commands are separated by spaces, and the number of
+    // tokens is fixed for all but setTextGrid
+    QStringList tokens = command.split(" ", QString::SkipEmptyParts);
+    int size = 0;
+    if (function == "setWall") {
+        parsed->function = DrawFunction::SET_WALL;
+        size = 4;
+    }
+    else if (function == "clearWall") {
+        parsed->function = DrawFunction::CLEAR_WALL;
+        size = 4;
+    }
+    else if (function == "setColor") {
+        parsed->function = DrawFunction::SET_COLOR;
+        size = 4;
+    }
+    else if (function == "setColorRect") {
+        parsed->function = DrawFunction::SET_COLOR_RECT;
+        size = 6;
+    }
+    else if (function == "clearColor") {
+        parsed->function = DrawFunction::CLEAR_COLOR;
+        size = 3;
+    }
+    else if (function == "clearAllColor") {
+        parsed->function = DrawFunction::CLEAR_ALL_COLOR;
+        size = 1;
+    }
+    else if (function == "setTextGrid") {
+        parsed->function = DrawFunction::SET_TEXT_GRID;
+        size = tokens.size();
+        if (size < 5) {
+            return false;
+        }
+    }
+    else if (function == "clearText") {
+        parsed->function = DrawFunction::CLEAR_TEXT;
+        size = 3;
+    }
+    else if (function == "clearAllText") {
+        parsed->function = DrawFunction::CLEAR_ALL_TEXT;
+        size = 1;
+    }
+    else {
+        return false;
+    }
+    if (tokens.size() != size) {
+        return false;
+    }
+
+    // Every command with arguments starts with the cell
+    if (1 < size) {
+        bool xOk = true;
+        bool yOk = true;
+        parsed->x = tokens.at(1).toInt(&xOk);
+        parsed->y = tokens.at(2).toInt(&yOk);
+        if (!xOk || !yOk) {
+            return false;
+        }
+    }
+    switch (parsed->function) {
+        case DrawFunction::SET_WALL:
+        case DrawFunction::CLEAR_WALL: {
+            if (tokens.at(3).size() != 1) {
+                return false;
+            }
+            parsed->value = tokens.at(3).at(0);
+            return CHAR_TO_DIRECTION().contains(parsed->value);
+        }
+        case DrawFunction::SET_COLOR_RECT: {
+            bool x2Ok = true;
+            bool y2Ok = true;
+            parsed->x2 = tokens.at(3).toInt(&x2Ok);
+            parsed->y2 = tokens.at(4).toInt(&y2Ok);
+            if (!x2Ok || !y2Ok || tokens.at(5).size() != 1) {
+                return false;
+            }
+            parsed->value = tokens.at(5).at(0);
+            return CHAR_TO_COLOR().contains(parsed->value);
+        }
+        case DrawFunction::SET_COLOR: {
+            if (tokens.at(3).size() != 1) {
+                return false;
+            }
+            parsed->value = tokens.at(3).at(0);
+            return CHAR_TO_COLOR().contains(parsed->value);
+        }
+        case DrawFunction::SET_TEXT_GRID: {
+            bool ok = true;
+            parsed->width = tokens.at(3).toInt(&ok);
+            if (!ok || parsed->width < 1) {
+                return false;
+            }
+            parsed->text = tokens.mid(4);
+            return true;
+        }
+        case DrawFunction::CLEAR_COLOR:
+        case DrawFunction::CLEAR_ALL_COLOR:
+        case DrawFunction::CLEAR_TEXT:
+        case DrawFunction::CLEAR_ALL_TEXT:
+            return true;
+        default:
+            ASSERT_NEVER_RUNS();
+    }
+}
+
+void MouseSession::executeDrawCommand(const DrawCommand& command) {
+    switch (command.function) {
+        case DrawFunction::SET_WALL:
+            setWall(command.x, command.y, command.value);
+            break;
+        case DrawFunction::CLEAR_WALL:
+            clearWall(command.x, command.y, command.value);
+            break;
+        case DrawFunction::SET_COLOR:
+            setColor(command.x, command.y, command.value);
+            break;
+        case DrawFunction::SET_COLOR_RECT:
+            setColorRect(
+                command.x, command.y, command.x2, command.y2, command.value);
+            break;
+        case DrawFunction::CLEAR_COLOR:
+            clearColor(command.x, command.y);
+            break;
+        case DrawFunction::CLEAR_ALL_COLOR:
+            clearAllColor();
+            break;
+        case DrawFunction::SET_TEXT:
+            setText(command.x, command.y, command.text.first());
+            break;
+        case DrawFunction::SET_TEXT_GRID:
+            setTextGrid(command.x, command.y, command.width, command.text);
+            break;
+        case DrawFunction::CLEAR_TEXT:
+            clearText(command.x, command.y);
+            break;
+        case DrawFunction::CLEAR_ALL_TEXT:
+            clearAllText();
+            break;
+        default:
+            ASSERT_NEVER_RUNS();
+    }
+}
+
+bool MouseSession::canReadCommand() const {
+    return (
+        m_process != nullptr &&
+        !m_commandQueue.isFull() &&
+        m_process->canReadLine()
+    );
+}
+
+void MouseSession::checkBufferedBytes() {
+    if (m_wasFlooded || m_process->bytesAvailable() <= MAX_BUFFERED_BYTES) {
+        return;
+    }
+    // The algorithm isn't waiting for responses, and would otherwise run the
+    // simulator out of memory; the kill is reported once the process exits
+    m_wasFlooded = true;
+    m_runOutput->appendLine(
+        QString("Killed: more than %1 MB of commands were waiting to be read")
+            .arg(MAX_BUFFERED_BYTES / 1024 / 1024));
+    m_process->kill();
+}
+
+QString MouseSession::readCommand() {
+    QString command = m_process->readLine();
+    command.replace("\r", "");  // Windows compatibility
+    if (command.endsWith("\n")) {
+        command.chop(1);
+    }
+    return command;
+}
+
+bool MouseSession::parseCommand(QString command, SerialCommand* parsed) const {
+    QStringList tokens = command.split(" ", QString::SkipEmptyParts);
+    if (tokens.size() < 1 || tokens.size() > 2) {
+        return false;
+    }
+    QString function = tokens.at(0);
+    if (tokens.size() == 2 &&
+            !(function == "moveForward" ||
+              function == "path" ||
+              function == "getStat" ||
+              function == "enable")) {
+        return false;
+    }
+    parsed->distance = 1;
+    parsed->stat = StatsEnum::TOTAL_DISTANCE;
+    parsed->argument = QString();
+    if (function == "mazeWidth") {
+        parsed->function = CommandFunction::MAZE_WIDTH;
+    }
+    else if (function == "mazeHeight") {
+        parsed->function = CommandFunction::MAZE_HEIGHT;
+    }
+    else if (function == "wallFront") {
+        parsed->function = CommandFunction::WALL_FRONT;
+    }
+    else if (function == "wallRight") {
+        parsed->function = CommandFunction::WALL_RIGHT;
+    }
+    else if (function == "wallLeft") {
+        parsed->function = CommandFunction::WALL_LEFT;
+    }
+    else if (function == "walls") {
+        parsed->function = CommandFunction::WALLS;
+    }
+    else if (function == "moveForward") {
+        parsed->function = CommandFunction::MOVE_FORWARD;
+        if (tokens.size() == 2) {
+            parsed->distance = tokens.at(1).toInt();
+        }
+    }
+    else if (function == "turnRight") {
+        parsed->function = CommandFunction::TURN_RIGHT;
+    }
+    else if (function == "turnLeft") {
+        parsed->function = CommandFunction::TURN_LEFT;
+    }
+    else if (function == "path") {
+        if (tokens.size() != 2) {
+            return false;
+        }
+        parsed->function = CommandFunction::PATH;
+        parsed->argument = tokens.at(1);
+    }
+    else if (function == "wasReset") {
+        parsed->function = CommandFunction::WAS_RESET;
+    }
+    else if (function == "ackReset") {
+        parsed->function = CommandFunction::ACK_RESET;
+    }
+    else if (function == "enable") {
+        if (tokens.size() != 2) {
+            return false;
+        }
+        parsed->function = CommandFunction::ENABLE;
+        parsed->argument = tokens.at(1);
+    }
+    else if (function == "getStat") {
+        if (tokens.size() != 2) {
+            return false;
+        }
+        parsed->function = CommandFunction::GET_STAT;
+        QString stat = tokens.at(1);
+        // Convert stat to a StatsEnum
+        if (stat == "total-distance") {
+            parsed->stat = StatsEnum::TOTAL_DISTANCE;
+        }
+        else if (stat == "total-turns") {
+            parsed->stat = StatsEnum::TOTAL_TURNS;
+        }
+        else if (stat == "best-run-distance") {
+            parsed->stat = StatsEnum::BEST_RUN_DISTANCE;
+        }
+        else if (stat == "best-run-turns") {
+            parsed->stat = StatsEnum::BEST_RUN_TURNS;
+        }
+        else if (stat == "current-run-distance") {
+            parsed->stat = StatsEnum::CURRENT_RUN_DISTANCE;
+        }
+        else if (stat == "current-run-turns") {
+            parsed->stat = StatsEnum::CURRENT_RUN_TURNS;
+        }
+        else if (stat == "total-effective-distance") {
+            parsed->stat = StatsEnum::TOTAL_EFFECTIVE_DISTANCE;
+        }
+        else if (stat == "best-run-effective-distance") {
+            parsed->stat = StatsEnum::BEST_RUN_EFFECTIVE_DISTANCE;
+        }
+        else if (stat == "current-run-effective-distance") {
+            parsed->stat = StatsEnum::CURRENT_RUN_EFFECTIVE_DISTANCE;
+        }
+        else if (stat == "score") {
+            parsed->stat = StatsEnum::SCORE;
+        }
+        else if (stat == "queue-depth") {
+            parsed->stat = StatsEnum::QUEUE_DEPTH;
+        }
+        else if (stat == "queue-time") {
+            parsed->stat = StatsEnum::QUEUE_TIME;
+        }
+        else if (stat == "cpu-user-time") {
+            parsed->stat = StatsEnum::CPU_USER_TIME;
+        }
+        else if (stat == "cpu-system-time") {
+            parsed->stat = StatsEnum::CPU_SYSTEM_TIME;
+        }
+        else if (stat == "cpu-time-per-move") {
+            parsed->stat = StatsEnum::CPU_TIME_PER_MOVE;
+        }
+        else if (stat == "peak-memory") {
+            parsed->stat = StatsEnum::PEAK_MEMORY;
+        }
+        else {
+            return false;
+        }
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+QString MouseSession::executeCommand(const SerialCommand& command) {
+    switch (command.function) {
+        case CommandFunction::MAZE_WIDTH:
+            return QString::number(mazeWidth());
+        case CommandFunction::MAZE_HEIGHT:
+            return QString::number(mazeHeight());
+        case CommandFunction::WALL_FRONT:
+            return boolToString(wallFront(0));
+        case CommandFunction::WALL_RIGHT:
+            return boolToString(wallRight());
+        case CommandFunction::WALL_LEFT:
+            return boolToString(wallLeft());
+        case CommandFunction::WALLS:
+            return QString::number(walls());
+        case CommandFunction::MOVE_FORWARD:
+            return moveForward(command.distance) ? "" : CRASH;
+        case CommandFunction::TURN_RIGHT:
+            turnRight();
+            return "";
+        case CommandFunction::TURN_LEFT:
+            turnLeft();
+            return "";
+        case CommandFunction::PATH:
+            return path(command.argument);
+        case CommandFunction::WAS_RESET:
+            return boolToString(wasReset());
+        case CommandFunction::ACK_RESET:
+            ackReset();
+            return ACK;
+        case CommandFunction::ENABLE:
+            return boolToString(enable(command.argument));
+        case CommandFunction::GET_STAT: {
+            // Make sure the live stats include this very command
+            updateQueueMetrics();
+            sampleUsage();
+            QString statValue = m_stats->getStat(command.stat);
+            if (statValue == "") {
+                // Cannot return an empty string. Return -1 to indicate empty field.
+                return "-1";
+            }
+            return statValue;
+        }
+    }
+    ASSERT_NEVER_RUNS();
+}
+
+void MouseSession::processCommands() {
+
+    // Handle at most a slice's worth of commands, so that the other sessions
+    // (and the map) get a turn on the event loop in between slices
+    int budget = MAX_COMMANDS_PER_SLICE;
+
+    // First dispatch the lines that have been read from the process, as long
+    // as there's room for them in the queue
+    while (canReadCommand() && 0 < budget) {
+        dispatchCommand(readCommand());
+        budget -= 1;
+    }
+
+    // Then execute the serial commands, in order
+    while (!m_commandQueue.isEmpty() && !m_isPaused && 0 < budget) {
+        QString response = "";
+        if (isMoving()) {
+            updateMouseProgress(m_movementStepSize);
+            if (!isMoving()) {
+                response = getMovementResponse();
+            }
+        }
+        else {
+            const SerialCommand& command = m_commandQueue.head();
+            m_lastQueueTime = m_queueClock.elapsed() - command.queuedAt;
+            response = executeCommand(command);
+        }
+        if (!response.isEmpty()) {
+            // Drop all invalid commands on the floor
+            if (response != INVALID) {
+                m_process->write((response + "\n").toStdString().c_str());
+            }
+            m_commandQueue.dequeue();
+            budget -= 1;
+        }
+        else {
+            // The timer will resume processing once the movement step is done
+            scheduleMouseProgressUpdate();
+            updateQueueMetrics();
+            return;
+        }
+    }
+    updateQueueMetrics();
+
+    // If the slice was used up, yield and pick up where we left off
+    bool hasIncoming = canReadCommand();
+    bool hasQueued = !m_commandQueue.isEmpty() && !m_isPaused;
+    if ((hasIncoming || hasQueued) && !m_commandQueueTimer->isActive()) {
+        m_commandQueueTimer->start(0);
+    }
+}
+
+double MouseSession::progressRequired(Movement movement) {
+    switch (movement) {
+        case Movement::MOVE_FORWARD:
+            return PROGRESS_REQUIRED_FOR_MOVE;
+        case Movement::TURN_RIGHT:
+        case Movement::TURN_LEFT:
+            return PROGRESS_REQUIRED_FOR_TURN;
+        default:
+            ASSERT_NEVER_RUNS();
+    }
+}
+
+void MouseSession::updateMouseProgress(double progress) {
+
+    // Determine the destination of the mouse.
+    QPair<int, int> destinationLocation = m_startingLocation;
+    Angle destinationRotation =
+        DIRECTION_TO_ANGLE().value(m_startingDirection);
+    if (m_movement == Movement::MOVE_FORWARD) {
+        if (m_startingDirection == Direction::NORTH) {
+            destinationLocation.second += 1;
+        }
+        else if (m_startingDirection == Direction::EAST) {
+            destinationLocation.first += 1;
+        }
+        else if (m_startingDirection == Direction::SOUTH) {
+            destinationLocation.second -= 1;
+        }
+        else if (m_startingDirection == Direction::WEST) {
+            destinationLocation.first -= 1;
+        }
+        else {
+            ASSERT_NEVER_RUNS();
+        }
+    }
+    // Explicity add or subtract 90 degrees so that the mouse is guaranteed to
+    // only rotate 90 degrees (using DIRECTION_ROTATE can cause the mouse to
+    // rotate 270 degrees in the opposite direction in some cases)
+    else if (m_movement == Movement::TURN_RIGHT) {
+        destinationRotation -= Angle::Degrees(90);
+    }
+    else if (m_movement == Movement::TURN_LEFT) {
+        destinationRotation += Angle::Degrees(90);
+    }
+    else {
+        ASSERT_NEVER_RUNS();
+    }
+
+    // Increment the movement progress, calculate fraction complete
+    m_movementProgress += progress;
+    double required = progressRequired(m_movement);
+    double remaining = required - m_movementProgress;
+    if (remaining < 0) {
+        remaining = 0;
+    }
+    double fraction = 1.0 - (remaining / required);
+
+    // Calculate the current translation and rotation
+    Coordinate startingTranslation =
+        getCenterOfTile(m_startingLocation.first, m_startingLocation.second);
+    Coordinate destinationTranslation =
+        getCenterOfTile(destinationLocation.first, destinationLocation.second);
+    Angle startingRotation =
+        DIRECTION_TO_ANGLE().value(m_startingDirection);
+    Coordinate currentTranslation =
+        startingTranslation * (1.0 - fraction) +
+        destinationTranslation * fraction;
+    Angle currentRotation =
+        startingRotation * (1.0 - fraction) +
+        destinationRotation * fraction;
+
+    // Teleport the mouse, reset movement state if done
+    m_mouse->teleport(currentTranslation, currentRotation);
+    if (remaining == 0.0) {
+        m_startingLocation = m_mouse->getCurrentDiscretizedTranslation();
+        m_startingDirection = m_mouse->getCurrentDiscretizedRotation();
+        m_movementProgress = 0.0;
+        m_movementStepSize = 0.0;
+        if (m_movement == Movement::MOVE_FORWARD) {
+            m_movesRemaining -= 1;
+        }
+        if (m_movesRemaining == 0) {
+            m_movement = Movement::NONE;
+        }
+        // determine if the goal was reached
+        if (m_maze->isInCenter(m_startingLocation)) {
+            m_stats->finishRun(); // record a completed start-to-finish run
+        }
+        else if (m_startingLocation.first == 0 && m_startingLocation.second == 0) {
+            m_stats->endUnfinishedRun();
+        }
+    }
+}
+
+void MouseSession::scheduleMouseProgressUpdate() {
+    
+    // Calculate progressRemaining, should be nonzero
+    double required = progressRequired(m_movement);
+    double progressRemaining = required - m_movementProgress;
+    ASSERT_LT(0.0, progressRemaining);
+
+    // Calculate progressPerSecond for non-linear slider
+    double value = static_cast<double>(m_speedSlider->value());
+    double fraction = value / m_speedSlider->maximum();
+    double rangeMin = qPow(MIN_PROGRESS_PER_SECOND, .25);
+    double rangeMax = qPow(MAX_PROGRESS_PER_SECOND, .25);
+    double rangeValue = (1.0 - fraction) * rangeMin + fraction * rangeMax;
+    double progressPerSecond = qPow(rangeValue, 4);
+
+    // Determine seconds remaing
+    double secondsRemaining = progressRemaining / progressPerSecond;
+    if (secondsRemaining > MAX_SLEEP_SECONDS) {
+        secondsRemaining = MAX_SLEEP_SECONDS;
+        progressRemaining = secondsRemaining * progressPerSecond;
+    }
+
+    // Update step size, set the timer
+    m_movementStepSize = progressRemaining;
+    m_commandQueueTimer->start(secondsRemaining * 1000);
+}
+
+bool MouseSession::isMoving() {
+    return m_movement != Movement::NONE;
+}
+
+QString MouseSession::getMovementResponse() {
+    if (m_pathIndex != -1) {
+        if (m_doomedToCrash) {
+            QString response = CRASH + " " + QString::number(m_pathIndex);
+            m_path.clear();
+            m_pathIndex = -1;
+            return response;
+        }
+        if (!m_path.isEmpty()) {
+            return startPathStep();
+        }
+        m_pathIndex = -1;
+    }
+    if (m_doomedToCrash) {
+        return CRASH;
+    }
+    if (m_senseOnArrival) {
+        // Saves asking for the walls of the arrival cell
+        return ACK + " " + QString::number(walls());
+    }
+    return ACK;
+}
+
+int MouseSession::mazeWidth() {
+    return m_maze->getWidth();
+}
+
+int MouseSession::mazeHeight() {
+    return m_maze->getHeight();
+}
+
+bool MouseSession::wallFront(int distance) {
+    QPair<int, int> position = m_mouse->getCurrentDiscretizedTranslation();
+    Direction direction = m_mouse->getCurrentDiscretizedRotation();
+    switch (direction) {
+        case Direction::NORTH:
+            position.second += distance;
+            break;
+        case Direction::SOUTH:
+            position.second -= distance;
+            break;
+        case Direction::EAST:
+            position.first += distance;
+            break;
+        case Direction::WEST:
+            position.first -= distance;
+            break;
+    }
+    return isWall({position.first, position.second, direction});
+}
+
+bool MouseSession::wallRight() {
+    QPair<int, int> position = m_mouse->getCurrentDiscretizedTranslation();
+    Direction direction = m_mouse->getCurrentDiscretizedRotation();
+    return m_maze->getSenseMask(position.first, position.second, direction) &
+        Maze::SENSE_RIGHT;
+}
+
+bool MouseSession::wallLeft() {
+    QPair<int, int> position = m_mouse->getCurrentDiscretizedTranslation();
+    Direction direction = m_mouse->getCurrentDiscretizedRotation();
+    return m_maze->getSenseMask(position.first, position.second, direction) &
+        Maze::SENSE_LEFT;
+}
+
+int MouseSession::walls() {
+    QPair<int, int> position = m_mouse->getCurrentDiscretizedTranslation();
+    Direction direction = m_mouse->getCurrentDiscretizedRotation();
+    // Like the individual queries, there's no sensing the wall behind
+    return m_maze->getSenseMask(position.first, position.second, direction) &
+        (Maze::SENSE_FRONT | Maze::SENSE_RIGHT | Maze::SENSE_LEFT);
+}
+
+bool MouseSession::moveForward(int distance) {
+    // Non-positive distances aren't allowed
+    if (distance < 1) {
+        return false;
+    }
+    // Special case for a wall directly in front of the mouse, else
+    // the wall won't be detected until after the mouse starts moving
+    if (wallFront(0)) {
+        return false;
+    }
+    // Compute the number of allowable moves
+    int moves = 1;
+    while (moves < distance) {
+        if (wallFront(moves)) {
+            break;
+        }
+        moves += 1;
+    }
+    m_movement = Movement::MOVE_FORWARD;
+    m_doomedToCrash = (moves != distance);
+    m_movesRemaining = moves;
+    if (m_startingLocation.first == 0 && m_startingLocation.second == 0) {
+        m_stats->startRun();
+    }
+    // increase the stats by the distance that will be travelled
+    m_stats->addDistance(moves);
+    return true;
+}
+
+void MouseSession::turnRight() {
+    m_movement = Movement::TURN_RIGHT;
+    m_doomedToCrash = false;
+    m_movesRemaining = 0;
+    m_stats->addTurn();
+}
+
+void MouseSession::turnLeft() {
+    m_movement = Movement::TURN_LEFT;
+    m_doomedToCrash = false;
+    m_movesRemaining = 0;
+    m_stats->addTurn();
+}
+
+QString MouseSession::path(QString moves) {
+
+    // Each move is F, R, or L, optionally followed by a count; a count of
+    // forward moves is a distance, like moveForward, and a count of turns
+    // is the same as repeating the turn
+    QQueue<PathStep> steps;
+    int position = 0;
+    int index = 0;
+    while (position < moves.size()) {
+        QChar letter = moves.at(position);
+        position += 1;
+        int end = position;
+        while (end < moves.size() && moves.at(end).isDigit()) {
+            end += 1;
+        }
+        int count = 1;
+        if (position < end) {
+            bool ok = true;
+            count = moves.mid(position, end - position).toInt(&ok);
+            if (!ok || count < 1) {
+                return INVALID;
+            }
+        }
+        position = end;
+        if (letter == 'F') {
+            steps.enqueue({Movement::MOVE_FORWARD, count, index});
+        }
+        else if (letter == 'R') {
+            steps.enqueue({Movement::TURN_RIGHT, count, index});
+        }
+        else if (letter == 'L') {
+            steps.enqueue({Movement::TURN_LEFT, count, index});
+        }
+        else {
+            return INVALID;
+        }
+        index += 1;
+    }
+    if (steps.isEmpty()) {
+        return INVALID;
+    }
+    m_path = steps;
+    return startPathStep();
+}
+
+QString MouseSession::startPathStep() {
+
+    // Forward moves are made all at once, turns one at a time
+    PathStep step = m_path.head();
+    m_pathIndex = step.index;
+    if (step.movement == Movement::MOVE_FORWARD || step.count == 1) {
+        m_path.dequeue();
+    }
+    else {
+        m_path.head().count -= 1;
+    }
+    switch (step.movement) {
+        case Movement::MOVE_FORWARD:
+            if (!moveForward(step.count)) {
+                m_path.clear();
+                m_pathIndex = -1;
+                return CRASH + " " + QString::number(step.index);
+            }
+            return "";
+        case Movement::TURN_RIGHT:
+            turnRight();
+            return "";
+        case Movement::TURN_LEFT:
+            turnLeft();
+            return "";
+        default:
+            ASSERT_NEVER_RUNS();
+    }
+}
+
+void MouseSession::setWall(int x, int y, QChar direction) {
+    if (!isWithinMaze(x, y)) {
+        return;
+    }
+    if (!CHAR_TO_DIRECTION().contains(direction)) {
+        return;
+    }
+    Direction d = CHAR_TO_DIRECTION().value(direction);
+    m_view->getMazeGraphic()->setWall(x, y, d);
+    Wall opposingWall = getOpposingWall({x, y, d});
+    if (isWithinMaze(opposingWall.x, opposingWall.y)) {
+        m_view->getMazeGraphic()->setWall(
+            opposingWall.x,
+            opposingWall.y,
+            opposingWall.d
+        ); 
+    }
+}
+
+void MouseSession::clearWall(int x, int y, QChar direction) {
+    if (!isWithinMaze(x, y)) {
+        return;
+    }
+    if (!CHAR_TO_DIRECTION().contains(direction)) {
+        return;
+    }
+    Direction d = CHAR_TO_DIRECTION().value(direction);
+    m_view->getMazeGraphic()->clearWall(x, y, d);
+    Wall opposingWall = getOpposingWall({x, y, d});
+    if (isWithinMaze(opposingWall.x, opposingWall.y)) {
+        m_view->getMazeGraphic()->clearWall(
+            opposingWall.x,
+            opposingWall.y,
+            opposingWall.d
+        ); 
+    }
+}
+
+void MouseSession::setColor(int x, int y, QChar color) {
+    if (!isWithinMaze(x, y)) {
+        return;
+    }
+    if (!CHAR_TO_COLOR().contains(color)) {
+        return;
+    }
+    m_view->getMazeGraphic()->setColor(x, y, CHAR_TO_COLOR().value(color));
+}
+
+void MouseSession::setColorRect(int x1, int y1, int x2, int y2, QChar color) {
+    if (!CHAR_TO_COLOR().contains(color)) {
+        return;
+    }
+    // The corners may be given in any order, and the
+    // rectangle is clipped to the bounds of the maze
+    int left = std::max(std::min(x1, x2), 0);
+    int right = std::min(std::max(x1, x2), m_maze->getWidth() - 1);
+    int bottom = std::max(std::min(y1, y2), 0);
+    int top = std::min(std::max(y1, y2), m_maze->getHeight() - 1);
+    Color value = CHAR_TO_COLOR().value(color);
+    for (int x = left; x <= right; x += 1) {
+        for (int y = bottom; y <= top; y += 1) {
+            m_view->getMazeGraphic()->setColor(x, y, value);
+        }
+    }
+}
+
+void MouseSession::clearColor(int x, int y) {
+    if (!isWithinMaze(x, y)) {
+        return;
+    }
+    m_view->getMazeGraphic()->clearColor(x, y);
+}
+
+void MouseSession::clearAllColor() {
+    m_view->getMazeGraphic()->clearAllColor();
+}
+
+void MouseSession::setText(int x, int y, QString text) {
+    if (!isWithinMaze(x, y)) {
+        return;
+    }
+    static QRegExp regex = QRegExp(
+        QString("[^") + FontImage::characters() + QString("]")
+    );
+    text.replace(regex, "?");
+    m_view->getMazeGraphic()->setText(x, y, text);
+}
+
+void MouseSession::setTextGrid(
+        int x, int y, int width, const QStringList& values) {
+    // Values fill the grid left to right, and then bottom to top
+    for (int i = 0; i < values.size(); i += 1) {
+        setText(x + i % width, y + i / width, values.at(i));
+    }
+}
+
+void MouseSession::clearText(int x, int y) {
+    if (!isWithinMaze(x, y)) {
+        return;
+    }
+    m_view->getMazeGraphic()->clearText(x, y);
+}
+
+void MouseSession::clearAllText() {
+    m_view->getMazeGraphic()->clearAllText();
+}
+
+bool MouseSession::wasReset() {
+    return m_wasReset;
+}
+
+void MouseSession::ackReset() {
+    m_mouse->reset();
+    m_startingLocation = {0, 0};
+    m_startingDirection = Direction::NORTH;
+    m_movement = Movement::NONE;
+    m_movementProgress = 0.0;
+    m_movementStepSize = 0.0;
+    m_wasReset = false;
+    m_stats->penalizeForReset();
+    m_stats->endUnfinishedRun();
+    emit resetAcknowledged();
+}
+
+bool MouseSession::enable(QString feature) {
+    if (feature == "sense-on-arrival") {
+        m_senseOnArrival = true;
+        return true;
+    }
+    if (feature == "reset-events") {
+        m_resetEvents = true;
+        return true;
+    }
+    return false;
+}
+
+QString MouseSession::boolToString(bool value) const {
+    return value ? "true" : "false";
+}
+
+bool MouseSession::isWall(Wall wall) const {
+    return m_maze->isWall(wall.x, wall.y, wall.d);
+}
+
+bool MouseSession::isWithinMaze(int x, int y) const {
+    return (
+        0 <= x && x < m_maze->getWidth() &&
+        0 <= y && y < m_maze->getHeight()
+    );
+}
+
+Wall MouseSession::getOpposingWall(Wall wall) const {
+    switch (wall.d) {
+        case Direction::NORTH:
+            return {wall.x, wall.y + 1, Direction::SOUTH};
+        case Direction::EAST:
+            return {wall.x + 1, wall.y, Direction::WEST};
+        case Direction::SOUTH:
+            return {wall.x, wall.y - 1, Direction::NORTH};
+        case Direction::WEST:
+            return {wall.x - 1, wall.y, Direction::EAST};
+    }
+}
+
+Coordinate MouseSession::getCenterOfTile(int x, int y) const {
+    ASSERT_TR(isWithinMaze(x, y));
+    Coordinate centerOfTile = Coordinate::Cartesian(
+        Dimensions::tileLength() * (static_cast<double>(x) + 0.5),
+        Dimensions::tileLength() * (static_cast<double>(y) + 0.5)
+    );
+    return centerOfTile;
+}
+
+} 
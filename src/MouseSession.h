@@ -0,0 +1,308 @@
+#pragma once
+
+#include <QChar>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPair>
+#include <QProcess>
+#include <QQueue>
+#include <QSlider>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include "LogConsole.h"
+#include "Maze.h"
+#include "MazeView.h"
+#include "Mouse.h"
+#include "MouseGraphic.h"
+#include "ProcessUtilities.h"
+#include "RingBuffer.h"
+#include "Stats.h"
+
+namespace mms {
+
+enum class Movement {
+    MOVE_FORWARD,
+    TURN_RIGHT,
+    TURN_LEFT,
+    NONE,
+};
+
+struct Wall {
+    int x;
+    int y;
+    Direction d;
+};
+
+// A single move of a path, see MouseSession::path()
+struct PathStep {
+    Movement movement;
+    int count; // the distance to move forward, or the number of turns
+    int index; // of the move within the path, reported if it crashes
+};
+
+// The commands that elicit a response
+enum class CommandFunction {
+    MAZE_WIDTH,
+    MAZE_HEIGHT,
+    WALL_FRONT,
+    WALL_RIGHT,
+    WALL_LEFT,
+    WALLS,
+    MOVE_FORWARD,
+    TURN_RIGHT,
+    TURN_LEFT,
+    PATH,
+    WAS_RESET,
+    ACK_RESET,
+    GET_STAT,
+    ENABLE,
+};
+
+// A command that elicits a response, parsed as soon as it's read, so that
+// only the commands with text arguments hold on to any strings
+struct SerialCommand {
+    CommandFunction function;
+    int distance; // for MOVE_FORWARD
+    StatsEnum stat; // for GET_STAT
+    QString argument; // the moves for PATH, or the feature for ENABLE
+    qint64 queuedAt; // see MouseSession::m_queueClock
+};
+
+// The commands that don't elicit a response
+enum class DrawFunction {
+    SET_WALL,
+    CLEAR_WALL,
+    SET_COLOR,
+    SET_COLOR_RECT,
+    CLEAR_COLOR,
+    CLEAR_ALL_COLOR,
+    SET_TEXT,
+    SET_TEXT_GRID,
+    CLEAR_TEXT,
+    CLEAR_ALL_TEXT,
+};
+
+// A command that doesn't elicit a response, also parsed as soon as it's read,
+// so that a batch holds only what's needed to apply each command
+struct DrawCommand {
+    DrawFunction function;
+    int x;
+    int y;
+    int x2; // for SET_COLOR_RECT
+    int y2; // for SET_COLOR_RECT
+    int width; // for SET_TEXT_GRID
+    QChar value; // the direction or the color
+    QStringList text; // the text for SET_TEXT, the values for SET_TEXT_GRID
+};
+
+// A single mouse algorithm running in the maze: its process, its mouse,
+// its view of the maze, and the command queue that connects them. The
+// Window owns one session per racing mouse; the stats and run output
+// widgets are owned by the Window and only borrowed here.
+class MouseSession : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    // The session's view of the maze starts out as a copy of the given one,
+    // which must not have been changed by any earlier run
+    MouseSession(
+        const Maze* maze,
+        const MazeView* view,
+        Stats* stats,
+        LogConsole* runOutput,
+        const QSlider* speedSlider,
+        int index);
+    ~MouseSession();
+
+    // Returns false (and logs the reason) if the process couldn't be started
+    bool start(const QString& runCommand, const QString& directory);
+    void cancel();
+    bool isRunning() const;
+    bool exitedNormally() const;
+
+    MazeView* getView() const;
+    const MouseGraphic* getMouseGraphic() const;
+
+    void setPaused(bool paused);
+    void requestReset();
+    bool isWaitingForReset() const;
+
+signals:
+
+    void exited();
+    void resetAcknowledged();
+
+private:
+
+    // ----- Borrowed state -----
+
+    const Maze* m_maze;
+    Stats* m_stats;
+    LogConsole* m_runOutput;
+    const QSlider* m_speedSlider;
+
+    // ----- Owned state -----
+
+    QProcess* m_process;
+    Mouse* m_mouse;
+    MazeView* m_view;
+    MouseGraphic* m_mouseGraphic;
+    bool m_exitedNormally;
+
+    void onProcessExit(int exitCode, QProcess::ExitStatus exitStatus);
+
+    // ----- Pause/reset ----
+
+    bool m_isPaused;
+    bool m_wasReset;
+
+    // ----- Communication -----
+
+    static const QString ACK;
+    static const QString CRASH;
+    static const QString INVALID;
+    static const QString RESET;
+
+    // The maximum number of commands handled before yielding back to the
+    // event loop, which keeps a chatty algorithm from starving the others
+    static const int MAX_COMMANDS_PER_SLICE;
+
+    // Buffer to hold incomplete output, only
+    // process once terminated with a newline
+    QStringList m_logBuffer;
+    QStringList processText(QString text, QStringList* buffer);
+
+    // Commands are read from the process one line at a time, and only while
+    // the command queue has room, so that an algorithm that writes commands
+    // faster than they're executed can't make the queue grow without bound.
+    // QProcess still drains the pipe into its own buffer, though, so the run
+    // is killed if the unread output ever grows past MAX_BUFFERED_BYTES.
+    static const qint64 MAX_BUFFERED_BYTES;
+    bool m_wasFlooded;
+    bool canReadCommand() const;
+    QString readCommand();
+    void checkBufferedBytes();
+
+    // Commands that elicit a response, executed in order
+    static const int MAX_QUEUED_COMMANDS;
+    RingBuffer<SerialCommand> m_commandQueue;
+    QTimer* m_commandQueueTimer;
+
+    // For the queue metrics, see Stats::setQueueMetrics()
+    QElapsedTimer m_queueClock;
+    qint64 m_lastQueueTime;
+    void updateQueueMetrics();
+
+    // The algorithm's CPU time and memory are sampled on a timer, rather than
+    // per command, so the cost doesn't grow with the command rate; the last
+    // sample is what's reported once the process has exited
+    static const int USAGE_SAMPLE_INTERVAL_MS;
+    QTimer* m_usageTimer;
+    bool m_hasUsage;
+    ProcessUsage m_usage;
+    void sampleUsage();
+
+    // Opt-in protocol features, see enable()
+    bool m_senseOnArrival; // movement acks carry the walls, see walls()
+    bool m_resetEvents; // RESET is written as soon as a reset is requested
+
+    // No-response commands received between beginBatch and endBatch, which
+    // are applied together so that the batch is drawn in a single frame. A
+    // longer batch than MAX_BATCHED_COMMANDS is applied (and drawn) in parts.
+    static const int MAX_BATCHED_COMMANDS;
+    bool m_isBatching;
+    QVector<DrawCommand> m_batch;
+    void applyBatch();
+
+    void dispatchCommand(QString command);
+    bool parseDrawCommand(QString command, DrawCommand* parsed) const;
+    void executeDrawCommand(const DrawCommand& command);
+    bool parseCommand(QString command, SerialCommand* parsed) const;
+    QString executeCommand(const SerialCommand& command);
+    void processCommands();
+
+    // ----- Movement -----
+
+    static const double PROGRESS_REQUIRED_FOR_MOVE;
+    static const double PROGRESS_REQUIRED_FOR_TURN;
+    static const double MIN_PROGRESS_PER_SECOND;
+    static const double MAX_PROGRESS_PER_SECOND;
+    static const double MAX_SLEEP_SECONDS;
+
+    QPair<int, int> m_startingLocation;
+    Direction m_startingDirection;
+    Movement m_movement;
+    bool m_doomedToCrash; // if the requested movement will result in a crash
+    int m_movesRemaining; // the number of allowable forward steps remaining
+    double m_movementProgress;
+    double m_movementStepSize;
+
+    // The rest of the path being followed, and the index of the move in
+    // progress, or -1 if the mouse isn't following a path
+    QQueue<PathStep> m_path;
+    int m_pathIndex;
+
+    double progressRequired(Movement movement);
+    void updateMouseProgress(double progress);
+    void scheduleMouseProgressUpdate();
+    bool isMoving();
+
+    // The response once a movement completes, or "" if a path continues
+    QString getMovementResponse();
+
+    // ----- API -----
+
+    int mazeWidth();
+    int mazeHeight();
+
+    bool wallFront(int distance);
+    bool wallRight();
+    bool wallLeft();
+    int walls(); // the SENSE_* bits of Maze, other than SENSE_BACK
+
+    bool moveForward(int distance);
+    void turnRight();
+    void turnLeft();
+
+    // Returns INVALID if the moves can't be parsed, else starts following
+    // them; see startPathStep()
+    QString path(QString moves);
+
+    // Starts the next move of the path, returns "" if the mouse is moving,
+    // else the response to the path
+    QString startPathStep();
+
+    void setWall(int x, int y, QChar direction);
+    void clearWall(int x, int y, QChar direction);
+
+    void setColor(int x, int y, QChar color);
+    void setColorRect(int x1, int y1, int x2, int y2, QChar color);
+    void clearColor(int x, int y);
+    void clearAllColor();
+
+    void setText(int x, int y, QString text);
+    void setTextGrid(int x, int y, int width, const QStringList& values);
+    void clearText(int x, int y);
+    void clearAllText();
+
+    bool wasReset();
+    void ackReset();
+
+    // Returns false if there's no such feature
+    bool enable(QString feature);
+
+    // ----- Helpers -----
+
+    QString boolToString(bool value) const;
+    bool isWall(Wall wall) const;
+    bool isWithinMaze(int x, int y) const;
+    Wall getOpposingWall(Wall wall) const;
+    Coordinate getCenterOfTile(int x, int y) const;
+};
+
+}
@@ -0,0 +1,88 @@
+#include "OrientedMaze.h"
+
+#include "AssertMacros.h"
+
+namespace mms {
+
+OrientedMaze::OrientedMaze(const Maze* maze, Symmetry symmetry) :
+    m_maze(maze),
+    m_symmetry(symmetry) {
+
+    // The symmetry mirrors and then swaps the axes, so undo it by swapping
+    // the view's axes and then mirroring
+    bool mirrorX = SYMMETRY_MIRRORS_X().value(symmetry);
+    bool mirrorY = SYMMETRY_MIRRORS_Y().value(symmetry);
+    bool swapAxes = SYMMETRY_SWAPS_AXES().value(symmetry);
+    m_width = swapAxes ? maze->getHeight() : maze->getWidth();
+    m_height = swapAxes ? maze->getWidth() : maze->getHeight();
+    m_x = mirrorX ? maze->getWidth() - 1 : 0;
+    m_y = mirrorY ? maze->getHeight() - 1 : 0;
+    m_xx = swapAxes ? 0 : (mirrorX ? -1 : 1);
+    m_xy = swapAxes ? (mirrorX ? -1 : 1) : 0;
+    m_yx = swapAxes ? (mirrorY ? -1 : 1) : 0;
+    m_yy = swapAxes ? 0 : (mirrorY ? -1 : 1);
+
+    for (int i = 0; i < DIRECTIONS().size(); i += 1) {
+        Direction direction = DIRECTIONS().at(i);
+        if (swapAxes) {
+            direction =
+                direction == Direction::NORTH ? Direction::EAST :
+                direction == Direction::EAST ? Direction::NORTH :
+                direction == Direction::SOUTH ? Direction::WEST :
+                Direction::SOUTH;
+        }
+        if (mirrorX && (
+            direction == Direction::EAST || direction == Direction::WEST
+        )) {
+            direction = DIRECTION_ROTATE_LEFT().value(
+                DIRECTION_ROTATE_LEFT().value(direction));
+        }
+        if (mirrorY && (
+            direction == Direction::NORTH || direction == Direction::SOUTH
+        )) {
+            direction = DIRECTION_ROTATE_LEFT().value(
+                DIRECTION_ROTATE_LEFT().value(direction));
+        }
+        m_directions[i] = direction;
+    }
+}
+
+const Maze* OrientedMaze::getMaze() const {
+    return m_maze;
+}
+
+Symmetry OrientedMaze::getSymmetry() const {
+    return m_symmetry;
+}
+
+int OrientedMaze::getWidth() const {
+    return m_width;
+}
+
+int OrientedMaze::getHeight() const {
+    return m_height;
+}
+
+int OrientedMaze::getDistance(int x, int y) const {
+    QPair<int, int> position = toMaze(x, y);
+    return m_maze->getDistance(position.first, position.second);
+}
+
+bool OrientedMaze::isWall(int x, int y, Direction direction) const {
+    QPair<int, int> position = toMaze(x, y);
+    return m_maze->isWall(position.first, position.second, toMaze(direction));
+}
+
+QPair<int, int> OrientedMaze::toMaze(int x, int y) const {
+    ASSERT_LE(0, x);
+    ASSERT_LE(0, y);
+    ASSERT_LT(x, m_width);
+    ASSERT_LT(y, m_height);
+    return {m_x + m_xx * x + m_xy * y, m_y + m_yx * x + m_yy * y};
+}
+
+Direction OrientedMaze::toMaze(Direction direction) const {
+    return m_directions[static_cast<int>(direction)];
+}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QPair>
+
+#include "Direction.h"
+#include "Maze.h"
+#include "Symmetry.h"
+
+namespace mms {
+
+// A maze as seen after rotating or mirroring it by a symmetry. The view
+// shares the maze's walls and distances, mapping each position and
+// direction back to the maze as it's looked up, so every orientation of a
+// maze is available without copying anything. The maze must outlive it.
+class OrientedMaze {
+
+public:
+
+    OrientedMaze(const Maze* maze, Symmetry symmetry);
+
+    const Maze* getMaze() const;
+    Symmetry getSymmetry() const;
+
+    // Like the methods of Maze, but in the view's coordinates
+    int getWidth() const;
+    int getHeight() const;
+    int getDistance(int x, int y) const;
+    bool isWall(int x, int y, Direction direction) const;
+
+    // The position or direction in the maze that the view's maps to; the
+    // start of the view is at toMaze(0, 0)
+    QPair<int, int> toMaze(int x, int y) const;
+    Direction toMaze(Direction direction) const;
+
+private:
+
+    const Maze* m_maze;
+    Symmetry m_symmetry;
+    int m_width;
+    int m_height;
+
+    // Position (x, y) of the view is position (m_x + m_xx * x + m_xy * y,
+    // m_y + m_yx * x + m_yy * y) of the maze
+    int m_x;
+    int m_xx;
+    int m_xy;
+    int m_y;
+    int m_yx;
+    int m_yy;
+
+    // Indexed like DIRECTIONS()
+    Direction m_directions[4];
+};
+
+}
@@ -46,6 +46,14 @@ Polygon::Polygon(QVector<Coordinate> vertices) :
             m_vertices.at(2),
         }};
     }
+    // Nearly every polygon is an axis-aligned rectangle (each tile is made of
+    // nine of them), which is convex and thus split along either diagonal
+    else if (isAxisAlignedRectangle(m_vertices)) {
+        m_triangles = {
+            {m_vertices.at(0), m_vertices.at(1), m_vertices.at(2)},
+            {m_vertices.at(0), m_vertices.at(2), m_vertices.at(3)},
+        };
+    }
 }
 
 QVector<Coordinate> Polygon::getVertices() const {
@@ -81,17 +89,20 @@ Polygon Polygon::translate(const Coordinate& translation) const {
 
 Polygon Polygon::rotateAroundPoint(const Angle& angle, const Coordinate& point) const {
 
+    // The sine and cosine are shared by every vertex
+    Rotation rotation(angle);
+
     QVector<Coordinate> vertices;
     for (const Coordinate& vertex : m_vertices) {
-        vertices.append(GeometryUtilities::rotateVertexAroundPoint(vertex, point, angle));
+        vertices.append(GeometryUtilities::rotateVertexAroundPoint(vertex, point, rotation));
     }
 
     QVector<Triangle> triangles;
     for (const Triangle& triangle : m_triangles) {
         triangles.append({
-            GeometryUtilities::rotateVertexAroundPoint(triangle.p1, point, angle),
-            GeometryUtilities::rotateVertexAroundPoint(triangle.p2, point, angle),
-            GeometryUtilities::rotateVertexAroundPoint(triangle.p3, point, angle),
+            GeometryUtilities::rotateVertexAroundPoint(triangle.p1, point, rotation),
+            GeometryUtilities::rotateVertexAroundPoint(triangle.p2, point, rotation),
+            GeometryUtilities::rotateVertexAroundPoint(triangle.p3, point, rotation),
         });
     }
 
@@ -107,6 +118,30 @@ bool Polygon::alreadyPerformedTriangulation() const {
     return 0 < m_triangles.size();
 }
 
+bool Polygon::isAxisAlignedRectangle(const QVector<Coordinate>& vertices) {
+    if (vertices.size() != 4) {
+        return false;
+    }
+    // Consecutive edges alternate between vertical and horizontal, starting
+    // with either
+    for (int start = 0; start < 2; start += 1) {
+        bool isRectangle = true;
+        for (int i = 0; i < 4; i += 1) {
+            const Coordinate& a = vertices.at(i);
+            const Coordinate& b = vertices.at((i + 1) % 4);
+            bool isVertical = (i + start) % 2 == 0;
+            if (isVertical ? a.getX() != b.getX() : a.getY() != b.getY()) {
+                isRectangle = false;
+                break;
+            }
+        }
+        if (isRectangle) {
+            return true;
+        }
+    }
+    return false;
+}
+
 QVector<Triangle> Polygon::triangulate(QVector<Coordinate> vertices) {
 
     // Populate the TPPLPoly
@@ -42,6 +42,10 @@ private:
     // throwing away information.
     bool alreadyPerformedTriangulation() const;
 
+    // Rectangles whose sides are parallel to the axes are triangulated
+    // directly, without going through polypartition
+    static bool isAxisAlignedRectangle(const QVector<Coordinate>& vertices);
+
     // Actually peforms the triangulation of the polygon.
     static QVector<Triangle> triangulate(QVector<Coordinate> vertices);
 
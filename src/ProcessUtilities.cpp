@@ -1,7 +1,12 @@
 #include "ProcessUtilities.h"
 
+#include <QFile>
 #include <QStringList>
 
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
 namespace mms {
 
 bool ProcessUtilities::start(
@@ -20,4 +25,58 @@ bool ProcessUtilities::start(
     return process->waitForStarted();
 }
 
-} 
+bool ProcessUtilities::getUsage(qint64 pid, ProcessUsage* usage) {
+#ifdef Q_OS_LINUX
+    QString directory = QString("/proc/%1/").arg(pid);
+
+    // The command name (the second field) is in parentheses and may contain
+    // spaces, so count the fields from the closing parenthesis, which is
+    // followed by the third field. See proc(5) for the rest.
+    QFile statFile(directory + "stat");
+    if (!statFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QString stat = statFile.readAll();
+    int end = stat.lastIndexOf(')');
+    if (end == -1) {
+        return false;
+    }
+    QStringList fields = stat.mid(end + 2).split(" ", QString::SkipEmptyParts);
+    if (fields.size() < 15) {
+        return false;
+    }
+    // Fields 14-17: utime, stime, cutime, cstime, in clock ticks
+    double msPerTick = 1000.0 / sysconf(_SC_CLK_TCK);
+    usage->userMilliseconds = msPerTick * (
+        fields.at(11).toDouble() + fields.at(13).toDouble());
+    usage->systemMilliseconds = msPerTick * (
+        fields.at(12).toDouble() + fields.at(14).toDouble());
+
+    // The peak resident set size, e.g., "VmHWM:\t    1234 kB"
+    QFile statusFile(directory + "status");
+    if (!statusFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QString status = statusFile.readAll();
+    int start = status.indexOf("VmHWM:");
+    if (start == -1) {
+        // Only a zombie has no memory statistics
+        usage->peakResidentKilobytes = -1;
+        return true;
+    }
+    start += QString("VmHWM:").size();
+    QString line = status.mid(start, status.indexOf("\n", start) - start);
+    QStringList value = line.trimmed().split(" ", QString::SkipEmptyParts);
+    if (value.isEmpty()) {
+        return false;
+    }
+    usage->peakResidentKilobytes = value.at(0).toLongLong();
+    return true;
+#else
+    Q_UNUSED(pid);
+    Q_UNUSED(usage);
+    return false;
+#endif
+}
+
+}
@@ -2,9 +2,17 @@
 
 #include <QProcess>
 #include <QString>
+#include <QtGlobal>
 
 namespace mms {
 
+// The resources that a process has used so far, see getUsage()
+struct ProcessUsage {
+    double userMilliseconds;
+    double systemMilliseconds;
+    qint64 peakResidentKilobytes; // -1 once the process has exited
+};
+
 class ProcessUtilities {
 
 public:
@@ -15,6 +23,14 @@ public:
         const QString& command,
         const QString& directory,
         QProcess* process);
+
+    // Samples the CPU time (including that of any children it has waited for)
+    // and the peak resident memory of a running process. This only reads a
+    // couple of small files from /proc, so it's cheap enough to call often;
+    // returns false if the process is gone, or if /proc isn't available. A
+    // process that has exited but not yet been reaped still reports its CPU
+    // time, but its memory is already released, so its peak is unknown.
+    static bool getUsage(qint64 pid, ProcessUsage* usage);
 };
 
 } 
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QVector>
+
+#include "AssertMacros.h"
+
+namespace mms {
+
+// A fixed-capacity FIFO queue, which allocates all of its slots up front and
+// never allocates again; the caller decides what to do once it's full
+template <typename T>
+class RingBuffer {
+
+public:
+
+    RingBuffer(int capacity);
+
+    int capacity() const;
+    int size() const;
+    bool isEmpty() const;
+    bool isFull() const;
+
+    // Index zero is the oldest element
+    const T& at(int i) const;
+    T& head();
+
+    void enqueue(const T& value);
+    void dequeue();
+    void clear();
+
+private:
+
+    QVector<T> m_slots;
+    int m_first;
+    int m_size;
+
+};
+
+template <typename T>
+RingBuffer<T>::RingBuffer(int capacity) :
+    m_slots(QVector<T>(capacity)),
+    m_first(0),
+    m_size(0) {
+    ASSERT_LT(0, capacity);
+}
+
+template <typename T>
+int RingBuffer<T>::capacity() const {
+    return m_slots.size();
+}
+
+template <typename T>
+int RingBuffer<T>::size() const {
+    return m_size;
+}
+
+template <typename T>
+bool RingBuffer<T>::isEmpty() const {
+    return m_size == 0;
+}
+
+template <typename T>
+bool RingBuffer<T>::isFull() const {
+    return m_size == m_slots.size();
+}
+
+template <typename T>
+const T& RingBuffer<T>::at(int i) const {
+    ASSERT_LE(0, i);
+    ASSERT_LT(i, m_size);
+    return m_slots.at((m_first + i) % m_slots.size());
+}
+
+template <typename T>
+T& RingBuffer<T>::head() {
+    ASSERT_LT(0, m_size);
+    return m_slots[m_first];
+}
+
+template <typename T>
+void RingBuffer<T>::enqueue(const T& value) {
+    ASSERT_FA(isFull());
+    m_slots[(m_first + m_size) % m_slots.size()] = value;
+    m_size += 1;
+}
+
+template <typename T>
+void RingBuffer<T>::dequeue() {
+    ASSERT_LT(0, m_size);
+    // Release anything the element holds on to, e.g., string data
+    m_slots[m_first] = T();
+    m_first = (m_first + 1) % m_slots.size();
+    m_size -= 1;
+}
+
+template <typename T>
+void RingBuffer<T>::clear() {
+    while (!isEmpty()) {
+        dequeue();
+    }
+}
+
+}
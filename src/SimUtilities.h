@@ -6,6 +6,7 @@
 
 #include "Color.h"
 #include "Polygon.h"
+#include "Triangle.h"
 #include "TriangleGraphic.h"
 
 namespace mms {
@@ -20,6 +21,12 @@ public:
     // Like time() in <ctime> but higher resolution (returns seconds since epoch)
     static double getHighResTimestamp();
 
+    // Converts a triangle to a triangle graphic of a single color
+    static TriangleGraphic triangleToTriangleGraphic(
+        const Triangle& triangle,
+        Color color,
+        unsigned char alpha);
+
     // Converts a polygon to a vector of triangle graphics
     static QVector<TriangleGraphic> polygonToTriangleGraphics(
         const Polygon& polygon,
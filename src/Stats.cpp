@@ -32,8 +32,23 @@ void Stats::resetAll() {
             statValues[key] = 0;
             textField[key]->setText("");
         }
-        else if (key == StatsEnum::SCORE) {
-            // Score is set in updateScore()
+        else if (
+            key == StatsEnum::CPU_USER_TIME ||
+            key == StatsEnum::CPU_SYSTEM_TIME ||
+            key == StatsEnum::CPU_TIME_PER_MOVE ||
+            key == StatsEnum::PEAK_MEMORY
+        ) {
+            // Display no value until the algorithm's usage is sampled, see
+            // setProcessUsage(), so that getStat() reports -1 until then
+            statValues[key] = 0;
+            textField[key]->setText("");
+        }
+        else if (key == StatsEnum::SCORE || key == StatsEnum::PERCENT_OF_OPTIMAL) {
+            // Score and percent of optimal are set in updateScore()
+            continue;
+        }
+        else if (key == StatsEnum::OPTIMAL_SCORE) {
+            // Optimal score depends only on the maze, see setOptimalScore()
             continue;
         }
         else {
@@ -87,6 +102,16 @@ void Stats::updateScore() {
         score = 2000; // default score
     }
     textField[StatsEnum::SCORE]->setText(QString::number(score));
+
+    // 100% means the best run was as good as possible; display no value
+    // until a start-to-finish run is recorded
+    QString percent;
+    float optimalScore = statValues[StatsEnum::OPTIMAL_SCORE];
+    if (solved && 0 < optimalScore) {
+        float bestScore = statValues[StatsEnum::BEST_RUN_EFFECTIVE_DISTANCE] + statValues[StatsEnum::BEST_RUN_TURNS];
+        percent = QString::number(100 * bestScore / optimalScore, 'f', 1);
+    }
+    textField[StatsEnum::PERCENT_OF_OPTIMAL]->setText(percent);
 }
 
 float Stats::getEffectiveDistance(int distance) {
@@ -127,6 +152,35 @@ void Stats::penalizeForReset() {
     penalty = 15;
 }
 
+void Stats::setOptimalScore(float score) {
+    statValues[StatsEnum::OPTIMAL_SCORE] = score;
+    textField[StatsEnum::OPTIMAL_SCORE]->setText(0 <= score ? QString::number(score) : "");
+    updateScore();
+}
+
+void Stats::setQueueMetrics(int depth, float time) {
+    // Called often, so only touch the text fields if something changed
+    if (statValues[StatsEnum::QUEUE_DEPTH] != depth) {
+        setStat(StatsEnum::QUEUE_DEPTH, depth);
+    }
+    if (statValues[StatsEnum::QUEUE_TIME] != time) {
+        setStat(StatsEnum::QUEUE_TIME, time);
+    }
+}
+
+void Stats::setProcessUsage(float userTime, float systemTime, float peakMemory) {
+    // CPU times are only accurate to a clock tick, so whole ms are plenty
+    setStat(StatsEnum::CPU_USER_TIME, qRound(userTime));
+    setStat(StatsEnum::CPU_SYSTEM_TIME, qRound(systemTime));
+    if (0 <= peakMemory) {
+        setStat(StatsEnum::PEAK_MEMORY, qRound(peakMemory * 10) / 10.0);
+    }
+    float moves = statValues[StatsEnum::TOTAL_DISTANCE] + statValues[StatsEnum::TOTAL_TURNS];
+    if (0 < moves) {
+        setStat(StatsEnum::CPU_TIME_PER_MOVE, qRound((userTime + systemTime) / moves * 100) / 100.0);
+    }
+}
+
 bool Stats::isInteger(StatsEnum stat) {
     // Returns true if the stat represents an integer value
     return (stat == StatsEnum::TOTAL_DISTANCE
@@ -135,6 +189,9 @@ bool Stats::isInteger(StatsEnum stat) {
             || stat == StatsEnum::BEST_RUN_TURNS
             || stat == StatsEnum::CURRENT_RUN_DISTANCE
             || stat == StatsEnum::CURRENT_RUN_TURNS
+            || stat == StatsEnum::QUEUE_DEPTH
+            || stat == StatsEnum::CPU_USER_TIME
+            || stat == StatsEnum::CPU_SYSTEM_TIME
             );
 }
 
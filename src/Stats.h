@@ -15,7 +15,15 @@ enum class StatsEnum{
     TOTAL_EFFECTIVE_DISTANCE,
     BEST_RUN_EFFECTIVE_DISTANCE,
     CURRENT_RUN_EFFECTIVE_DISTANCE,
-    SCORE // has a text box but is not saved in an array
+    SCORE, // has a text box but is not saved in an array
+    OPTIMAL_SCORE, // the best run score that's possible in the maze
+    PERCENT_OF_OPTIMAL, // the best run score as a percentage of the optimal
+    QUEUE_DEPTH, // the number of queued commands, including the one in progress
+    QUEUE_TIME, // how long the latest command waited to be executed, in ms
+    CPU_USER_TIME, // the algorithm's CPU time in user mode, in ms
+    CPU_SYSTEM_TIME, // the algorithm's CPU time in kernel mode, in ms
+    CPU_TIME_PER_MOVE, // the total CPU time divided by the distance plus turns
+    PEAK_MEMORY // the algorithm's peak resident memory, in MB
 };
 
 class Stats
@@ -30,6 +38,9 @@ public:
     void finishRun(); // A run finishes when the mouse enters the goal.
     void endUnfinishedRun(); // A run ends unfinished when the mouse returns to the start tile
     void penalizeForReset(); // Applies a penalty when the mouse resets to the start tile
+    void setOptimalScore(float score); // Set when the maze changes, negative if the center can't be reached
+    void setQueueMetrics(int depth, float time); // Live metrics of the algorithm's command queue
+    void setProcessUsage(float userTime, float systemTime, float peakMemory); // Sampled while the algorithm runs, in ms and MB (negative if unknown)
     QString getStat(StatsEnum stat); // Return the current value of the requested stat
 
 private:
@@ -0,0 +1,75 @@
+#include "Symmetry.h"
+
+namespace mms {
+
+const QVector<Symmetry>& SYMMETRIES() {
+    static const QVector<Symmetry> vector = {
+        Symmetry::IDENTITY,
+        Symmetry::ROTATE_90,
+        Symmetry::ROTATE_180,
+        Symmetry::ROTATE_270,
+        Symmetry::MIRROR_X,
+        Symmetry::MIRROR_Y,
+        Symmetry::TRANSPOSE,
+        Symmetry::ANTI_TRANSPOSE,
+    };
+    return vector;
+}
+
+const QMap<Symmetry, QString>& SYMMETRY_TO_STRING() {
+    static const QMap<Symmetry, QString> map = {
+        {Symmetry::IDENTITY, "identity"},
+        {Symmetry::ROTATE_90, "rotate 90"},
+        {Symmetry::ROTATE_180, "rotate 180"},
+        {Symmetry::ROTATE_270, "rotate 270"},
+        {Symmetry::MIRROR_X, "mirror x"},
+        {Symmetry::MIRROR_Y, "mirror y"},
+        {Symmetry::TRANSPOSE, "transpose"},
+        {Symmetry::ANTI_TRANSPOSE, "anti-transpose"},
+    };
+    return map;
+}
+
+const QMap<Symmetry, bool>& SYMMETRY_MIRRORS_X() {
+    static const QMap<Symmetry, bool> map = {
+        {Symmetry::IDENTITY, false},
+        {Symmetry::ROTATE_90, true},
+        {Symmetry::ROTATE_180, true},
+        {Symmetry::ROTATE_270, false},
+        {Symmetry::MIRROR_X, true},
+        {Symmetry::MIRROR_Y, false},
+        {Symmetry::TRANSPOSE, false},
+        {Symmetry::ANTI_TRANSPOSE, true},
+    };
+    return map;
+}
+
+const QMap<Symmetry, bool>& SYMMETRY_MIRRORS_Y() {
+    static const QMap<Symmetry, bool> map = {
+        {Symmetry::IDENTITY, false},
+        {Symmetry::ROTATE_90, false},
+        {Symmetry::ROTATE_180, true},
+        {Symmetry::ROTATE_270, true},
+        {Symmetry::MIRROR_X, false},
+        {Symmetry::MIRROR_Y, true},
+        {Symmetry::TRANSPOSE, false},
+        {Symmetry::ANTI_TRANSPOSE, true},
+    };
+    return map;
+}
+
+const QMap<Symmetry, bool>& SYMMETRY_SWAPS_AXES() {
+    static const QMap<Symmetry, bool> map = {
+        {Symmetry::IDENTITY, false},
+        {Symmetry::ROTATE_90, true},
+        {Symmetry::ROTATE_180, false},
+        {Symmetry::ROTATE_270, true},
+        {Symmetry::MIRROR_X, false},
+        {Symmetry::MIRROR_Y, false},
+        {Symmetry::TRANSPOSE, true},
+        {Symmetry::ANTI_TRANSPOSE, true},
+    };
+    return map;
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+namespace mms {
+
+// The eight ways to rotate or mirror a maze. Each one keeps the center in
+// the center and moves the start to one of the corners. Rotations are
+// clockwise, and the transposes mirror across the diagonals.
+enum class Symmetry {
+    IDENTITY,
+    ROTATE_90,
+    ROTATE_180,
+    ROTATE_270,
+    MIRROR_X,
+    MIRROR_Y,
+    TRANSPOSE,
+    ANTI_TRANSPOSE,
+};
+
+// A convenient way to enumerate through all of the symmetries
+const QVector<Symmetry>& SYMMETRIES();
+
+const QMap<Symmetry, QString>& SYMMETRY_TO_STRING();
+
+// Every symmetry mirrors x (x -> width - 1 - x) and/or y, and then swaps
+// the axes, in that order, or some subset thereof
+const QMap<Symmetry, bool>& SYMMETRY_MIRRORS_X();
+const QMap<Symmetry, bool>& SYMMETRY_MIRRORS_Y();
+const QMap<Symmetry, bool>& SYMMETRY_SWAPS_AXES();
+
+}
@@ -0,0 +1,78 @@
+#include "TileGeometry.h"
+
+#include "AssertMacros.h"
+#include "Dimensions.h"
+
+namespace mms {
+
+Polygon TileGeometry::getFullPolygon(
+        int x, int y, int mazeWidth, int mazeHeight) {
+    Edges e = getEdges(x, y, mazeWidth, mazeHeight);
+    return getRectangle(e.outerLeft, e.outerBottom, e.outerRight, e.outerTop);
+}
+
+Polygon TileGeometry::getWallPolygon(
+        int x, int y, int mazeWidth, int mazeHeight, Direction direction) {
+    Edges e = getEdges(x, y, mazeWidth, mazeHeight);
+    switch (direction) {
+        case Direction::NORTH:
+            return getRectangle(
+                e.innerLeft, e.innerTop, e.innerRight, e.outerTop);
+        case Direction::EAST:
+            return getRectangle(
+                e.innerRight, e.innerBottom, e.outerRight, e.innerTop);
+        case Direction::SOUTH:
+            return getRectangle(
+                e.innerLeft, e.outerBottom, e.innerRight, e.innerBottom);
+        case Direction::WEST:
+            return getRectangle(
+                e.outerLeft, e.innerBottom, e.innerLeft, e.innerTop);
+    }
+    ASSERT_NEVER_RUNS();
+}
+
+QVector<Polygon> TileGeometry::getCornerPolygons(
+        int x, int y, int mazeWidth, int mazeHeight) {
+    Edges e = getEdges(x, y, mazeWidth, mazeHeight);
+    return {
+        getRectangle(e.outerLeft, e.outerBottom, e.innerLeft, e.innerBottom),
+        getRectangle(e.outerLeft, e.innerTop, e.innerLeft, e.outerTop),
+        getRectangle(e.innerRight, e.innerTop, e.outerRight, e.outerTop),
+        getRectangle(e.innerRight, e.outerBottom, e.outerRight, e.innerBottom),
+    };
+}
+
+TileGeometry::Edges TileGeometry::getEdges(
+        int x, int y, int mazeWidth, int mazeHeight) {
+    Distance halfWallWidth = Dimensions::halfWallWidth();
+    Distance tileLength = Dimensions::tileLength();
+    bool isLeft = x == 0;
+    bool isBottom = y == 0;
+    bool isRight = x == mazeWidth - 1;
+    bool isTop = y == mazeHeight - 1;
+    Edges e;
+    e.outerLeft = tileLength * x - halfWallWidth * (isLeft ? 1 : 0);
+    e.outerBottom = tileLength * y - halfWallWidth * (isBottom ? 1 : 0);
+    e.outerRight = tileLength * (x + 1) + halfWallWidth * (isRight ? 1 : 0);
+    e.outerTop = tileLength * (y + 1) + halfWallWidth * (isTop ? 1 : 0);
+    e.innerLeft = e.outerLeft + halfWallWidth * (isLeft ? 2 : 1);
+    e.innerBottom = e.outerBottom + halfWallWidth * (isBottom ? 2 : 1);
+    e.innerRight = e.outerRight - halfWallWidth * (isRight ? 2 : 1);
+    e.innerTop = e.outerTop - halfWallWidth * (isTop ? 2 : 1);
+    return e;
+}
+
+Polygon TileGeometry::getRectangle(
+        const Distance& left,
+        const Distance& bottom,
+        const Distance& right,
+        const Distance& top) {
+    return Polygon({
+        Coordinate::Cartesian(left, bottom),
+        Coordinate::Cartesian(left, top),
+        Coordinate::Cartesian(right, top),
+        Coordinate::Cartesian(right, bottom),
+    });
+}
+
+}
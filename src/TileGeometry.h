@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QVector>
+
+#include "Direction.h"
+#include "Polygon.h"
+#include "units/Distance.h"
+
+namespace mms {
+
+class TileGeometry {
+
+public:
+
+    // The TileGeometry class is not constructible
+    TileGeometry() = delete;
+
+    // The polygons of a tile are computed from its position on demand,
+    // rather than being stored for the lifetime of the maze:
+    //
+    //      full: 05af
+    //
+    //      interior: 278d
+    //
+    //      northWall: 7698
+    //      eastWall: d8be
+    //      southWall: 32dc
+    //      westWall: 1472
+    //
+    //      lowerLeftCorner: 0123
+    //      upperLeftCorner: 4567
+    //      upperRightCorner: 89ab
+    //      lowerRightCorner: cdef
+    //
+    //      5---6-------------9---a
+    //      |   |             |   |
+    //      4---7-------------8---b
+    //      |   |             |   |
+    //      |   |             |   |
+    //      |   |             |   |
+    //      |   |             |   |
+    //      |   |             |   |
+    //      1---2-------------d---e
+    //      |   |             |   |
+    //      0---3-------------c---f
+    //
+    // Tiles along the border of the maze are extended by half of a wall
+    // width, so that the outer walls are as thick as the inner walls
+
+    static Polygon getFullPolygon(
+        int x, int y, int mazeWidth, int mazeHeight);
+    static Polygon getWallPolygon(
+        int x, int y, int mazeWidth, int mazeHeight, Direction direction);
+
+    // In the order lower left, upper left, upper right, lower right
+    static QVector<Polygon> getCornerPolygons(
+        int x, int y, int mazeWidth, int mazeHeight);
+
+private:
+
+    struct Edges {
+        Distance outerLeft;
+        Distance outerBottom;
+        Distance outerRight;
+        Distance outerTop;
+        Distance innerLeft;
+        Distance innerBottom;
+        Distance innerRight;
+        Distance innerTop;
+    };
+
+    static Edges getEdges(int x, int y, int mazeWidth, int mazeHeight);
+    static Polygon getRectangle(
+        const Distance& left,
+        const Distance& bottom,
+        const Distance& right,
+        const Distance& top);
+};
+
+}
@@ -5,94 +5,150 @@
 #include "AssertMacros.h"
 #include "Color.h"
 #include "ColorManager.h"
-#include "FontImage.h"
+#include "TileGeometry.h"
+#include "WallGrid.h"
 
 namespace mms {
 
+const quint8 TileGraphic::PENDING_COLOR = 1;
+const quint8 TileGraphic::PENDING_TEXT = 2;
+
 TileGraphic::TileGraphic() {
     ASSERT_NEVER_RUNS();
 }
 
 TileGraphic::TileGraphic(
-    const Tile* tile,
+    const Maze* maze,
+    int x,
+    int y,
     BufferInterface* bufferInterface,
     bool isTruthView) :
-    m_tile(tile),
+    m_maze(maze),
+    m_x(x),
+    m_y(y),
     m_bufferInterface(bufferInterface),
+    m_walls(0),
     m_color(ColorManager::get()->getTileBaseColor()),
     m_colorWasSet(false),
+    m_pendingUpdates(0),
     m_isTruthView(isTruthView) {
 }
 
+TileGraphic::TileGraphic(
+    const TileGraphic& other,
+    BufferInterface* bufferInterface) :
+    TileGraphic(other) {
+    m_bufferInterface = bufferInterface;
+}
+
 void TileGraphic::setWall(Direction direction) {
-    m_walls[direction] = true;
+    m_walls |= WallGrid::getWallBit(direction);
     updateWall(direction);
 }
 
 void TileGraphic::clearWall(Direction direction) {
-    m_walls.remove(direction);
+    m_walls &= ~WallGrid::getWallBit(direction);
     updateWall(direction);
 }
 
 void TileGraphic::setColor(Color color) {
+    if (m_colorWasSet && color == m_color) {
+        return;
+    }
     m_color = color;
     m_colorWasSet = true;
-    updateColor();
+    m_pendingUpdates |= PENDING_COLOR;
 }
 
 void TileGraphic::clearColor() {
+    if (!m_colorWasSet) {
+        return;
+    }
     m_color = ColorManager::get()->getTileBaseColor();
     m_colorWasSet = false;
-    updateColor();
+    m_pendingUpdates |= PENDING_COLOR;
 }
 
 void TileGraphic::setText(const QString& text) {
+    // Algorithms tend to rewrite the same values over and over (e.g., on each
+    // pass of a floodfill), so don't bother if nothing has changed
+    if (text == m_text) {
+        return;
+    }
     m_text = text;
-    updateText();
+    m_pendingUpdates |= PENDING_TEXT;
 }
 
 void TileGraphic::clearText() {
+    if (m_text.isEmpty()) {
+        return;
+    }
     m_text = "";
-    updateText();
+    m_pendingUpdates |= PENDING_TEXT;
+}
+
+bool TileGraphic::hasPendingUpdates() const {
+    return m_pendingUpdates != 0;
+}
+
+void TileGraphic::flushUpdates() {
+    if (m_pendingUpdates & PENDING_COLOR) {
+        updateColor();
+    }
+    if (m_pendingUpdates & PENDING_TEXT) {
+        updateText();
+    }
+    m_pendingUpdates = 0;
 }
 
 void TileGraphic::drawPolygons() const {
 
-    // Note that the order in which we call insertIntoGraphicCpuBuffer
-    // determines the order in which the polygons are drawn. Also note that the
-    // *StartingIndex methods in GrahicsUtilities.h depend upon this order.
+    // Note that the index of each polygon determines the order in which the
+    // polygons are drawn. Also note that the *StartingIndex methods in
+    // BufferInterface depend upon this order.
+
+    // The geometry is computed here and discarded once it's in the buffer
+    int width = m_maze->getWidth();
+    int height = m_maze->getHeight();
 
     // Draw the base of the tile
-    m_bufferInterface->insertIntoGraphicCpuBuffer(
-        m_tile->getFullPolygon(), m_color, 255);
+    m_bufferInterface->setTileGraphicPolygon(
+        m_x,
+        m_y,
+        0,
+        TileGeometry::getFullPolygon(m_x, m_y, width, height),
+        m_color,
+        255);
 
     // Draw each of the walls of the tile
-    for (Direction direction : DIRECTIONS()) {
-        m_bufferInterface->insertIntoGraphicCpuBuffer(
-            m_tile->getWallPolygon(direction),
+    for (int i = 0; i < DIRECTIONS().size(); i += 1) {
+        Direction direction = DIRECTIONS().at(i);
+        m_bufferInterface->setTileGraphicPolygon(
+            m_x,
+            m_y,
+            1 + i,
+            TileGeometry::getWallPolygon(m_x, m_y, width, height, direction),
             getWallColor(direction),
             getWallAlpha(direction));
     }
 
     // Draw the corners of the tile
-    for (Polygon polygon : m_tile->getCornerPolygons()) {
-        m_bufferInterface->insertIntoGraphicCpuBuffer(
-            polygon,
+    QVector<Polygon> corners =
+        TileGeometry::getCornerPolygons(m_x, m_y, width, height);
+    for (int i = 0; i < corners.size(); i += 1) {
+        m_bufferInterface->setTileGraphicPolygon(
+            m_x,
+            m_y,
+            5 + i,
+            corners.at(i),
             ColorManager::get()->getTileCornerColor(),
             255);
     }
 }
 
 void TileGraphic::drawTextures() const {
-    // Insert all of the triangle texture objects into the buffer ...
-    QPair<int, int> maxRowsAndCols =
-        m_bufferInterface->getTileGraphicTextMaxSize();
-    for (int row = 0; row < maxRowsAndCols.first; row += 1) {
-        for (int col = 0; col < maxRowsAndCols.second; col += 1) {
-            m_bufferInterface->insertIntoTextureCpuBuffer();
-        }
-    }
-    // ... and then populate those triangle texture objects with data
+    // The triangle texture objects are already in the buffer (see
+    // BufferInterface::initTextureCpuBuffer), so just populate them
     updateText();
 }
 
@@ -105,8 +161,8 @@ void TileGraphic::refreshColors() {
 
 void TileGraphic::updateWall(Direction direction) const {
     m_bufferInterface->updateTileGraphicWallColor(
-        m_tile->getX(),
-        m_tile->getY(),
+        m_x,
+        m_y,
         direction,
         getWallColor(direction),
         getWallAlpha(direction)
@@ -118,8 +174,8 @@ void TileGraphic::updateColor() const {
     Color default_ = ColorManager::get()->getTileBaseColor();
     Color color = m_colorWasSet ? m_color : default_;
     m_bufferInterface->updateTileGraphicBaseColor(
-        m_tile->getX(),
-        m_tile->getY(),
+        m_x,
+        m_y,
         color);
 }
 
@@ -128,41 +184,32 @@ void TileGraphic::updateText() const {
     // First, retrieve the maximum number of rows and cols of text allowed
     QPair<int, int> maxRowsAndCols =
         m_bufferInterface->getTileGraphicTextMaxSize();
-
-    // Then, generate the rows of text that will be displayed
-    QStringList rowsOfText;
-
-    // Split the text into rows
-    QString remaining = m_text;
-    while (!remaining.isEmpty() && rowsOfText.size() < maxRowsAndCols.first) {
-        QString row = remaining.left(maxRowsAndCols.second);
-        rowsOfText.append(row);
-        remaining = remaining.mid(maxRowsAndCols.second);
+    int maxRows = maxRowsAndCols.first;
+    int maxCols = maxRowsAndCols.second;
+
+    // Then, determine how many rows the text is split into; the characters
+    // are read straight out of the text, so that nothing is allocated here
+    int length = m_text.size();
+    int numRows = 0;
+    while (numRows < maxRows && numRows * maxCols < length) {
+        numRows += 1;
     }
 
     // For all possible character positions, insert some character
     // (blank if necessary) into the tile text cpu buffer
-    for (int row = 0; row < maxRowsAndCols.first; row += 1) {
-        for (int col = 0; col < maxRowsAndCols.second; col += 1) {
-            int numRows = std::min(
-                static_cast<int>(rowsOfText.size()),
-                maxRowsAndCols.first
-            );
-            int numCols = std::min(
-                static_cast<int>(row < rowsOfText.size() ? rowsOfText.at(row).size() : 0),
-                maxRowsAndCols.second
-            );
+    for (int row = 0; row < maxRows; row += 1) {
+        int numCols = 0;
+        if (row < numRows) {
+            numCols = std::min(length - row * maxCols, maxCols);
+        }
+        for (int col = 0; col < maxCols; col += 1) {
             QChar c = ' ';
-            if (
-                row < rowsOfText.size() &&
-                col < rowsOfText.at(row).size()
-            ) {
-                c = rowsOfText.at(row).at(col);
+            if (col < numCols) {
+                c = m_text.at(row * maxCols + col);
             }
-            ASSERT_TR(FontImage::positions().contains(c));
             m_bufferInterface->updateTileGraphicText(
-                m_tile->getX(),
-                m_tile->getY(),
+                m_x,
+                m_y,
                 numRows,
                 numCols,
                 row,
@@ -174,7 +221,7 @@ void TileGraphic::updateText() const {
 }
 
 Color TileGraphic::getWallColor(Direction direction) const {
-    if (m_walls.value(direction)) {
+    if (m_walls & WallGrid::getWallBit(direction)) {
         if (m_isTruthView) {
             return ColorManager::get()->getTileWallColor();
         }
@@ -187,10 +234,10 @@ Color TileGraphic::getWallColor(Direction direction) const {
 }
 
 unsigned char TileGraphic::getWallAlpha(Direction direction) const {
-    if (m_walls.value(direction)) {
+    if (m_walls & WallGrid::getWallBit(direction)) {
         return 255;
     }
-    if (m_tile->isWall(direction)) {
+    if (m_maze->isWall(m_x, m_y, direction)) {
         if (m_isTruthView) {
             return 255;
         }
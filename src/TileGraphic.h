@@ -1,11 +1,11 @@
 #pragma once
 
-#include <QMap>
 #include <QPair>
+#include <QtGlobal>
 
 #include "BufferInterface.h"
 #include "Color.h"
-#include "Tile.h"
+#include "Maze.h"
 
 namespace mms {
 
@@ -15,19 +15,30 @@ public:
 
     TileGraphic();
     TileGraphic(
-        const Tile* tile,
+        const Maze* maze,
+        int x,
+        int y,
         BufferInterface* bufferInterface,
         bool isTruthView);
 
+    // A copy of another tile, which updates the given buffers instead
+    TileGraphic(const TileGraphic& other, BufferInterface* bufferInterface);
+
     void setWall(Direction direction);
     void clearWall(Direction direction);
 
+    // Color and text changes are only recorded here, and are written to the
+    // buffers by flushUpdates(), so that a tile that changes many times
+    // between two frames is only redrawn once
     void setColor(const Color color);
     void clearColor();
 
     void setText(const QString& text);
     void clearText();
 
+    bool hasPendingUpdates() const;
+    void flushUpdates();
+
     // TODO: upforgrabs
     // Rename these to "reload" or something
     void drawPolygons() const;
@@ -38,15 +49,22 @@ public:
 private:
 
     // Input and output objects
-    const Tile* m_tile;
+    const Maze* m_maze;
+    int m_x;
+    int m_y;
     BufferInterface* m_bufferInterface;
 
     // Visual state
-    QMap<Direction, bool> m_walls;
+    quint8 m_walls; // see WallGrid::getWallMask()
     Color m_color;
     bool m_colorWasSet;
     QString m_text;
 
+    // Which parts of the visual state haven't been written to the buffers
+    static const quint8 PENDING_COLOR;
+    static const quint8 PENDING_TEXT;
+    quint8 m_pendingUpdates;
+
     // Helper functions
     // TODO: upforgrabs
     // Rename these to "refresh" or something
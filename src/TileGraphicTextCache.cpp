@@ -12,6 +12,7 @@ void TileGraphicTextCache::init(
 
     m_wallLength = wallLength;
     m_wallWidth = wallWidth;
+    m_tileLength = wallLength + wallWidth;
     m_tileGraphicTextMaxSize = tileGraphicTextMaxSize;
     m_tileGraphicTextPositions = buildPositionCache();
 }
@@ -20,34 +21,41 @@ QPair<int, int> TileGraphicTextCache::getTileGraphicTextMaxSize() const {
     return m_tileGraphicTextMaxSize;
 }
 
-QPair<double, double> TileGraphicTextCache::getFontImageCharacterPosition(QChar c) const {
-    ASSERT_TR(FontImage::positions().contains(c));
-    return FontImage::positions().value(c);
+const QPair<double, double>& TileGraphicTextCache::getFontImageCharacterPosition(
+        QChar c) const {
+    ASSERT_TR(FontImage::hasGlyph(c));
+    return FontImage::glyphs().at(c.unicode());
 }
 
 QPair<Coordinate, Coordinate> TileGraphicTextCache::getTileGraphicTextPosition(
         int x, int y, int numRows, int numCols, int row, int col) const {
 
     // Get the character position in the maze for the starting tile
-    QPair<Coordinate, Coordinate> textPosition = m_tileGraphicTextPositions.value(
-        {
-            {numRows, numCols},
-            {row, col}
-        }
-    );
+    const QPair<Coordinate, Coordinate>& textPosition =
+        m_tileGraphicTextPositions.at(getSlotIndex(numRows, numCols, row, col));
 
     // Now get the character position in the maze for *this* tile
-    Distance tileLength = m_wallLength + m_wallWidth;
-    Coordinate offset = Coordinate::Cartesian(tileLength * x, tileLength * y);
+    Coordinate offset = Coordinate::Cartesian(m_tileLength * x, m_tileLength * y);
     Coordinate LL = textPosition.first + offset;
     Coordinate UR = textPosition.second + offset;
 
     return {LL, UR};
 }
 
-QMap<
-    QPair<QPair<int, int>, QPair<int, int>>,
-    QPair<Coordinate, Coordinate>>
+int TileGraphicTextCache::getSlotIndex(
+        int numRows, int numCols, int row, int col) const {
+    int maxRows = m_tileGraphicTextMaxSize.first;
+    int maxCols = m_tileGraphicTextMaxSize.second;
+    ASSERT_LE(0, numRows);
+    ASSERT_LE(numRows, maxRows);
+    ASSERT_LE(0, numCols);
+    ASSERT_LE(numCols, maxCols);
+    return (
+        ((numRows * (maxCols + 1) + numCols) * maxRows + row) * maxCols + col
+    );
+}
+
+QVector<QPair<Coordinate, Coordinate>>
 TileGraphicTextCache::buildPositionCache() {
 
     // The tile graphic text could look like either of the following, depending
@@ -71,12 +79,13 @@ TileGraphicTextCache::buildPositionCache() {
     //     *[A]--------------------------*-*    *[A]--------------------------*-*
     //     *-*---------------------------*-*    *-*---------------------------*-*
 
-    QMap<
-        QPair<QPair<int, int>, QPair<int, int>>,
-        QPair<Coordinate, Coordinate>> positionCache;
-
     int maxRows = m_tileGraphicTextMaxSize.first;
     int maxCols = m_tileGraphicTextMaxSize.second;
+
+    // Slots that aren't visible (i.e., blank characters) are left at the
+    // origin, so that they're drawn with zero area
+    QVector<QPair<Coordinate, Coordinate>> positionCache(
+        (maxRows + 1) * (maxCols + 1) * maxRows * maxCols);
     double borderFraction = 0.05;  // border padding
 
     // First we get the unscaled diagonal
@@ -124,13 +133,8 @@ TileGraphicTextCache::buildPositionCache() {
                     );
 
                     // Insert the position into the cache
-                    positionCache.insert(
-                        {
-                            {numRows, numCols}, // Num rows/cols to be drawn
-                            {row, col} // Row and col of the current character
-                        },
-                        {LL, UR} // Lower left and upper right texture coord
-                    );
+                    positionCache[getSlotIndex(numRows, numCols, row, col)] =
+                        {LL, UR}; // Lower left and upper right texture coord
                 }
             }
         }
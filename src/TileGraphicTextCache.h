@@ -1,8 +1,8 @@
 #pragma once
 
 #include <QChar>
-#include <QMap>
 #include <QPair>
+#include <QVector>
 
 #include "units/Coordinate.h"
 
@@ -22,7 +22,7 @@ public:
     QPair<int, int> getTileGraphicTextMaxSize() const;
 
     // Return a characters starting and ending position in the font image
-    QPair<double, double> getFontImageCharacterPosition(QChar c) const;
+    const QPair<double, double>& getFontImageCharacterPosition(QChar c) const;
 
     // Retrieve the LL and UR coordinates for a particular location
     QPair<Coordinate, Coordinate> getTileGraphicTextPosition(
@@ -34,19 +34,20 @@ private:
     Distance m_wallLength;
     Distance m_wallWidth;
 
+    // The distance between the origins of adjacent tiles
+    Distance m_tileLength;
+
     // The max rows and cols of text per tile
     QPair<int, int> m_tileGraphicTextMaxSize;
 
-    // A map of the number of rows/cols to be displayed and the current row/col
-    // to the LL/UR text coordinates for the starting tile, namely tile (0, 0)
-    QMap<
-        QPair<QPair<int, int>, QPair<int, int>>,
-        QPair<Coordinate, Coordinate>> m_tileGraphicTextPositions;
+    // The LL/UR text coordinates for the starting tile, namely tile (0, 0),
+    // for every number of rows/cols to be displayed and every row/col, laid
+    // out flat so that a lookup is just index arithmetic (see getSlotIndex)
+    QVector<QPair<Coordinate, Coordinate>> m_tileGraphicTextPositions;
+    int getSlotIndex(int numRows, int numCols, int row, int col) const;
 
     // Just a helper method for building the text position cache
-    QMap<
-        QPair<QPair<int, int>, QPair<int, int>>,
-        QPair<Coordinate, Coordinate>> buildPositionCache();
+    QVector<QPair<Coordinate, Coordinate>> buildPositionCache();
 };
 
 } 
@@ -0,0 +1,140 @@
+#include "WallGrid.h"
+
+#include <algorithm>
+
+#include "AssertMacros.h"
+
+namespace mms {
+
+WallGrid::WallGrid() : WallGrid(0, 0) {
+}
+
+WallGrid::WallGrid(int width, int height) :
+    m_width(width),
+    m_height(height),
+    m_horizontal(QVector<quint64>(getHorizontalWordCount(width, height), 0)),
+    m_vertical(QVector<quint64>(getVerticalWordCount(width, height), 0)) {
+    ASSERT_LE(0, width);
+    ASSERT_LE(0, height);
+}
+
+WallGrid::WallGrid(
+        int width,
+        int height,
+        const QVector<quint64>& horizontal,
+        const QVector<quint64>& vertical) :
+    m_width(width),
+    m_height(height),
+    m_horizontal(horizontal),
+    m_vertical(vertical) {
+    ASSERT_LE(0, width);
+    ASSERT_LE(0, height);
+    ASSERT_EQ(horizontal.size(), getHorizontalWordCount(width, height));
+    ASSERT_EQ(vertical.size(), getVerticalWordCount(width, height));
+}
+
+int WallGrid::getWidth() const {
+    return m_width;
+}
+
+int WallGrid::getHeight() const {
+    return m_height;
+}
+
+bool WallGrid::isWall(int x, int y, Direction direction) const {
+    int index = getIndex(x, y, direction);
+    return (getPlane(direction).at(index / 64) >> (index % 64)) & 1;
+}
+
+void WallGrid::setWall(int x, int y, Direction direction, bool isWall) {
+    int index = getIndex(x, y, direction);
+    quint64 bit = quint64(1) << (index % 64);
+    quint64& word = getPlane(direction)[index / 64];
+    word = isWall ? (word | bit) : (word & ~bit);
+}
+
+void WallGrid::fill(bool isWall) {
+    fillPlane(&m_horizontal, m_width * (m_height + 1), isWall);
+    fillPlane(&m_vertical, (m_width + 1) * m_height, isWall);
+}
+
+void WallGrid::copyWalls(const WallGrid& other) {
+    ASSERT_EQ(m_width, other.m_width);
+    ASSERT_EQ(m_height, other.m_height);
+    std::copy(
+        other.m_horizontal.constBegin(),
+        other.m_horizontal.constEnd(),
+        m_horizontal.begin());
+    std::copy(
+        other.m_vertical.constBegin(),
+        other.m_vertical.constEnd(),
+        m_vertical.begin());
+}
+
+quint8 WallGrid::getWallMask(int x, int y) const {
+    quint8 mask = 0;
+    for (Direction direction : DIRECTIONS()) {
+        if (isWall(x, y, direction)) {
+            mask |= getWallBit(direction);
+        }
+    }
+    return mask;
+}
+
+quint8 WallGrid::getWallBit(Direction direction) {
+    return 1 << static_cast<int>(direction);
+}
+
+const QVector<quint64>& WallGrid::getHorizontalWalls() const {
+    return m_horizontal;
+}
+
+const QVector<quint64>& WallGrid::getVerticalWalls() const {
+    return m_vertical;
+}
+
+int WallGrid::getHorizontalWordCount(int width, int height) {
+    // The number of bits may be as large as INT_MAX, so round it up to
+    // whole words in 64 bits
+    return static_cast<int>((qint64(width) * (qint64(height) + 1) + 63) / 64);
+}
+
+int WallGrid::getVerticalWordCount(int width, int height) {
+    return static_cast<int>(((qint64(width) + 1) * height + 63) / 64);
+}
+
+void WallGrid::fillPlane(QVector<quint64>* plane, int bits, bool isWall) {
+    plane->fill(isWall ? ~quint64(0) : 0);
+    // Keep the bits past the end of the plane clear
+    if (isWall && bits % 64 != 0) {
+        plane->last() &= (quint64(1) << (bits % 64)) - 1;
+    }
+}
+
+int WallGrid::getIndex(int x, int y, Direction direction) const {
+    switch (direction) {
+        case Direction::NORTH:
+            return (y + 1) * m_width + x;
+        case Direction::EAST:
+            return (x + 1) * m_height + y;
+        case Direction::SOUTH:
+            return y * m_width + x;
+        case Direction::WEST:
+            return x * m_height + y;
+    }
+    ASSERT_NEVER_RUNS();
+}
+
+const QVector<quint64>& WallGrid::getPlane(Direction direction) const {
+    bool isHorizontal =
+        direction == Direction::NORTH || direction == Direction::SOUTH;
+    return isHorizontal ? m_horizontal : m_vertical;
+}
+
+QVector<quint64>& WallGrid::getPlane(Direction direction) {
+    bool isHorizontal =
+        direction == Direction::NORTH || direction == Direction::SOUTH;
+    return isHorizontal ? m_horizontal : m_vertical;
+}
+
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QVector>
+#include <QtGlobal>
+
+#include "Direction.h"
+
+namespace mms {
+
+// Bit-packed storage for the walls of a maze. Horizontal and vertical walls
+// live in two separate bit planes that are shared by neighboring cells, so
+// each wall is stored exactly once and both of its sides always agree.
+//
+//     horizontal: (height + 1) rows of width bits, row y is the
+//                 southern edge of the cells in row y
+//     vertical:   (width + 1) columns of height bits, column x is
+//                 the western edge of the cells in column x
+//
+class WallGrid {
+
+public:
+
+    WallGrid();
+    WallGrid(int width, int height);
+
+    // Adopts existing bit planes, which must have the sizes given below
+    WallGrid(
+        int width,
+        int height,
+        const QVector<quint64>& horizontal,
+        const QVector<quint64>& vertical);
+
+    int getWidth() const;
+    int getHeight() const;
+
+    // The position must be within the grid
+    bool isWall(int x, int y, Direction direction) const;
+    void setWall(int x, int y, Direction direction, bool isWall);
+
+    // Sets every wall, or copies every wall of a grid of the same size, in
+    // place; the planes are only reallocated if they're shared with another
+    // grid, e.g., one that was copied from this one
+    void fill(bool isWall);
+    void copyWalls(const WallGrid& other);
+
+    // Bit i is set if there's a wall in direction DIRECTIONS().at(i)
+    quint8 getWallMask(int x, int y) const;
+    static quint8 getWallBit(Direction direction);
+
+    // The raw bit planes, e.g., for storing the walls elsewhere as they are
+    const QVector<quint64>& getHorizontalWalls() const;
+    const QVector<quint64>& getVerticalWalls() const;
+
+    // The number of words in each plane; the number of bits in each, e.g.,
+    // width * (height + 1), must be at most INT_MAX
+    static int getHorizontalWordCount(int width, int height);
+    static int getVerticalWordCount(int width, int height);
+
+private:
+
+    int m_width;
+    int m_height;
+    QVector<quint64> m_horizontal;
+    QVector<quint64> m_vertical;
+
+    int getIndex(int x, int y, Direction direction) const;
+    static void fillPlane(QVector<quint64>* plane, int bits, bool isWall);
+    const QVector<quint64>& getPlane(Direction direction) const;
+    QVector<quint64>& getPlane(Direction direction);
+};
+
+}
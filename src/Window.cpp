@@ -1,6 +1,7 @@
 #include "Window.h"
 
 #include <QAction>
+#include <QDateTime>
 #include <QDebug>
 #include <QDoubleSpinBox>
 #include <QFileDialog>
@@ -27,6 +28,9 @@
 #include "ConfigDialog.h"
 #include "Dimensions.h"
 #include "FontImage.h"
+#include "MazeCache.h"
+#include "MazeCorpus.h"
+#include "MazeGenerator.h"
 #include "ProcessUtilities.h"
 #include "SettingsMazeFiles.h"
 #include "SettingsMouseAlgos.h"
@@ -46,25 +50,23 @@ const QString Window::FAILED_STYLE_SHEET =
 const QString Window::ERROR_STYLE_SHEET =
     "QLabel { background: rgb(230, 150, 230); }";
 
-const QString Window::ACK = "ack";
-const QString Window::CRASH = "crash";
-const QString Window::INVALID = "invalid";
+const QString Window::GENERATE_MAZE_ENTRY = "generate";
+const int Window::GENERATED_MAZE_SIZE = 16;
+
+const int Window::MAX_MICE = 8;
 
 const int Window::SPEED_SLIDER_MAX = 99;
 const int Window::SPEED_SLIDER_DEFAULT = 33;
-const double Window::PROGRESS_REQUIRED_FOR_MOVE = 100.0;
-const double Window::PROGRESS_REQUIRED_FOR_TURN = 33.33;
-const double Window::MIN_PROGRESS_PER_SECOND = 10.0;
-const double Window::MAX_PROGRESS_PER_SECOND = 5000.0;
-const double Window::MAX_SLEEP_SECONDS = 0.008;
 
 Window::Window(QWidget *parent) :
     QMainWindow(parent),
     m_map(new Map()),
 
     // Maze
+    m_mazeEntry(nullptr),
     m_maze(nullptr),
     m_truth(nullptr),
+    m_fieldEngine(nullptr),
     m_currentMazeFile(QString()),
     m_mazeFileComboBox(new QComboBox()),
 
@@ -72,10 +74,16 @@ Window::Window(QWidget *parent) :
     m_mouseAlgoComboBox(new QComboBox()),
     m_mouseAlgoEditButton(new QToolButton()),
 
+    // Race config
+    m_raceButton(new QToolButton()),
+    m_raceMenu(new QMenu()),
+    m_raceAlgos(QSet<QString>()),
+
     // Algo output
     m_mouseAlgoOutputTabWidget(new QTabWidget()),
-    m_buildOutput(new QPlainTextEdit()),
-    m_runOutput(new QPlainTextEdit()),
+    m_buildOutput(new LogConsole()),
+    m_runOutputStack(new QStackedWidget()),
+    m_statsStack(new QStackedWidget()),
 
     // Algo build
     m_buildButton(new QPushButton("Build")),
@@ -84,37 +92,19 @@ Window::Window(QWidget *parent) :
 
     // Algo run
     m_runButton(new QPushButton("Run")),
-    m_runProcess(nullptr),
     m_runStatus(new QLabel()),
-    m_mouse(nullptr),
-    m_view(nullptr),
-    m_mouseGraphic(nullptr),
+
+    // View
+    m_viewComboBox(new QComboBox()),
+    m_overlayComboBox(new QComboBox()),
 
     // Pause/reset
     m_isPaused(false),
-    m_wasReset(false),
     m_pauseButton(new QPushButton("Pause")),
     m_resetButton(new QPushButton("Reset")),
 
-    // Communication
-    m_logBuffer(QStringList()),
-    m_commandBuffer(QStringList()),
-    m_commandQueue(QQueue<QString>()),
-    m_commandQueueTimer(new QTimer()),
-
     // Movement
-    m_startingLocation({0, 0}),
-    m_startingDirection(Direction::NORTH),
-    m_movement(Movement::NONE),
-    m_doomedToCrash(false),
-    m_movesRemaining(0),
-    m_movementProgress(0.0),
-    m_movementStepSize(0.0),
-    m_speedSlider(new QSlider(Qt::Horizontal)),
-
-    // Helpers
-    m_tilesWithColor(QSet<QPair<int, int>>()),
-    m_tilesWithText(QSet<QPair<int, int>>()) {
+    m_speedSlider(new QSlider(Qt::Horizontal)) {
 
     // Keyboard shortcuts for closing the window
     QShortcut* ctrl_q = new QShortcut(QKeySequence(Qt::CTRL + Qt::Key_Q), this);
@@ -144,9 +134,6 @@ Window::Window(QWidget *parent) :
     upperLayout->addWidget(controlsGroupBox);
     upperLayout->addWidget(configGroupBox);
     panelLayout->addLayout(upperLayout);
-    QWidget* statsWidget = new QWidget();
-    QGridLayout* statsLayout = new QGridLayout();
-    statsWidget->setLayout(statsLayout);
 
     // Add the mouse algo build and run buttons
     controlsLayout->addWidget(m_buildButton, 0, 0);
@@ -197,11 +184,17 @@ Window::Window(QWidget *parent) :
     // Add config box labels
     QLabel* mazeLabel = new QLabel("Maze");
     QLabel* mouseLabel = new QLabel("Mouse");
+    QLabel* viewLabel = new QLabel("View");
+    QLabel* overlayLabel = new QLabel("Overlay");
     configLayout->addWidget(mazeLabel, 0, 0, 1, 1);
     configLayout->addWidget(mouseLabel, 1, 0, 1, 1);
+    configLayout->addWidget(viewLabel, 2, 0, 1, 1);
+    configLayout->addWidget(overlayLabel, 3, 0, 1, 1);
     QSizePolicy policy = QSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
     mazeLabel->setSizePolicy(policy);
     mouseLabel->setSizePolicy(policy);
+    viewLabel->setSizePolicy(policy);
+    overlayLabel->setSizePolicy(policy);
 
     // Add maze file combo box
     m_mazeFileComboBox->setMinimumContentsLength(1);
@@ -266,31 +259,62 @@ Window::Window(QWidget *parent) :
         &Window::onMouseAlgoImportButtonPressed
     );
 
-    // Add stats labels
-    stats = new Stats();
-    createStat("Total Distance", StatsEnum::TOTAL_DISTANCE, 0, 0, 0, 1, statsLayout);
-    createStat("Total Effective Distance", StatsEnum::TOTAL_EFFECTIVE_DISTANCE, 1, 0, 1, 1, statsLayout);
-    createStat("Total Turns", StatsEnum::TOTAL_TURNS, 2, 0, 2, 1, statsLayout);
-    createStat("Current Run Distance", StatsEnum::CURRENT_RUN_DISTANCE, 0, 2, 0, 3, statsLayout);
-    createStat("Current Run Effective Distance", StatsEnum::CURRENT_RUN_EFFECTIVE_DISTANCE, 1, 2, 1, 3, statsLayout);
-    createStat("Current Run Turns", StatsEnum::CURRENT_RUN_TURNS, 2, 2, 2, 3, statsLayout);
-    createStat("Best Run Distance", StatsEnum::BEST_RUN_DISTANCE, 3, 0, 3, 1, statsLayout);
-    createStat("Best Run Effective Distance", StatsEnum::BEST_RUN_EFFECTIVE_DISTANCE, 4, 0, 4, 1, statsLayout);
-    createStat("Best Run Turns", StatsEnum::BEST_RUN_TURNS, 5, 0, 5, 1, statsLayout);
-    createStat("Score", StatsEnum::SCORE, 6, 0, 6, 1, statsLayout);
+    // Add race button, which selects the algos racing against the mouse
+    m_raceButton->setText("Race");
+    m_raceButton->setMenu(m_raceMenu);
+    m_raceButton->setPopupMode(QToolButton::InstantPopup);
+    configLayout->addWidget(m_raceButton, 2, 3, 1, 2);
+
+    // Add view combo box, which selects the truth or one of the mice's views
+    m_viewComboBox->setMinimumContentsLength(1);
+    configLayout->addWidget(m_viewComboBox, 2, 1, 1, 2);
+    connect(
+        m_viewComboBox,
+        static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+        this,
+        &Window::onViewComboBoxChanged
+    );
+
+    // Add overlay combo box, which selects the field shown on the truth
+    for (Field field : FIELDS()) {
+        m_overlayComboBox->addItem(FIELD_TO_STRING().value(field));
+    }
+    m_overlayComboBox->setMinimumContentsLength(1);
+    configLayout->addWidget(m_overlayComboBox, 3, 1, 1, 4);
+    connect(
+        m_overlayComboBox,
+        static_cast<void(QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+        this,
+        &Window::onOverlayComboBoxChanged
+    );
+
+    // Add a run output and stats for each mouse slot
+    for (int i = 0; i < MAX_MICE; i += 1) {
+        LogConsole* runOutput = new LogConsole();
+        m_runOutputs.append(runOutput);
+        m_runOutputStack->addWidget(runOutput);
+        Stats* stats = new Stats();
+        m_stats.append(stats);
+        m_statsStack->addWidget(createStatsWidget(stats));
+    }
 
     // Add the build and run outputs to the panel
     panelLayout->addWidget(m_mouseAlgoOutputTabWidget);
     m_mouseAlgoOutputTabWidget->addTab(m_buildOutput, "Build Output");
-    m_mouseAlgoOutputTabWidget->addTab(m_runOutput, "Run Output");
-    m_mouseAlgoOutputTabWidget->addTab(statsWidget, "Stats");
-    for (QPlainTextEdit* output : {m_buildOutput, m_runOutput}) {
-        output->setReadOnly(true);
-        output->setLineWrapMode(QPlainTextEdit::NoWrap);
-        QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
-        font.setPointSize(10);
-        output->document()->setDefaultFont(font);
-    }
+    m_mouseAlgoOutputTabWidget->addTab(m_runOutputStack, "Run Output");
+    m_mouseAlgoOutputTabWidget->addTab(m_statsStack, "Stats");
+
+    // Filter the lines shown in all of the outputs at once
+    QLineEdit* outputFilter = new QLineEdit();
+    outputFilter->setPlaceholderText("Filter");
+    outputFilter->setClearButtonEnabled(true);
+    m_mouseAlgoOutputTabWidget->setCornerWidget(outputFilter);
+    connect(outputFilter, &QLineEdit::textChanged, this, [=](QString text){
+        m_buildOutput->setFilter(text);
+        for (LogConsole* runOutput : m_runOutputs) {
+            runOutput->setFilter(text);
+        }
+    });
 
     // Resize the window and make the map square
     int windowWidth = SettingsMisc::getRecentWindowWidth();
@@ -307,25 +331,17 @@ Window::Window(QWidget *parent) :
 
     // Load the recently used maze
     QString path = SettingsMisc::getRecentMazeFile();
-    Maze* maze = Maze::fromFile(path);
-    if (maze == nullptr) {
+    if (!showMaze(path)) {
         path = ":/resources/mazes/blank.num";
-        maze = Maze::fromFile(path);
+        showMaze(path);
     }
     refreshMazeFileComboBox(path);
-    updateMazeAndPath(maze, path);
 
     // Add the mouse algos
     refreshMouseAlgoComboBox(SettingsMisc::getRecentMouseAlgo());
 
-    // Configure command queue timer
-    m_commandQueueTimer->setSingleShot(true);
-    connect(
-        m_commandQueueTimer,
-        &QTimer::timeout,
-        this,
-        &Window::processQueuedCommands
-    );
+    // Only the truth can be viewed until mice are added
+    refreshViewComboBox({});
 
     // Start the graphics loop
     double secondsPerFrame = 1.0 / 60;
@@ -362,25 +378,84 @@ void Window::onMazeFileButtonPressed() {
     if (path.isNull()) {
         return;
     }
-    Maze* maze = Maze::fromFile(path);
-    if (maze == nullptr) {
+
+    // Corpora are listed by maze, so select the first one
+    QString selected = path;
+    MazeCorpus* corpus = MazeCorpus::open(path);
+    if (corpus != nullptr) {
+        if (0 < corpus->getCount()) {
+            selected =
+                MazeCorpus::getReference(path, corpus->getEntry(0).name);
+        }
+        delete corpus;
+    }
+    if (!showMaze(selected)) {
         showInvalidMazeFileWarning(path);
         return;
     }
     SettingsMazeFiles::addPath(path);
-    refreshMazeFileComboBox(path);
-    updateMazeAndPath(maze, path);
+    refreshMazeFileComboBox(selected);
 }
 
 void Window::onMazeFileComboBoxChanged(QString path) {
-    Maze* maze = Maze::fromFile(path);
-    if (maze == nullptr) {
+    if (path == GENERATE_MAZE_ENTRY) {
+        generateMaze();
+        return;
+    }
+    if (!showMaze(path)) {
         refreshMazeFileComboBox(m_currentMazeFile);
         showInvalidMazeFileWarning(path);
         return;
     }
-    updateMazeAndPath(maze, path);
-    stats->resetAll();
+    for (Stats* stats : m_stats) {
+        stats->resetAll();
+    }
+}
+
+void Window::generateMaze() {
+
+    // The seed is logged so that an interesting maze can be generated again;
+    // generated mazes aren't remembered as the recent maze file, but they're
+    // cached by seed like any other maze
+    quint64 seed = QDateTime::currentMSecsSinceEpoch();
+    QString key = GENERATE_MAZE_ENTRY + "#" + QString::number(seed);
+    MazeCache::Entry* entry = m_mazeCache.get(key);
+    if (entry == nullptr) {
+        MazeGenerator generator(
+            MazeAlgorithm::TOMASZ, GENERATED_MAZE_SIZE, GENERATED_MAZE_SIZE);
+        Maze* maze = Maze::fromWalls(generator.generate(seed));
+        ASSERT_FA(maze == nullptr);
+        entry = m_mazeCache.insert(key, maze);
+    }
+    qInfo().noquote() << "Generated a maze with seed" << seed;
+    updateMaze(entry);
+    m_currentMazeFile = GENERATE_MAZE_ENTRY;
+    for (Stats* stats : m_stats) {
+        stats->resetAll();
+    }
+}
+
+bool Window::showMaze(QString path) {
+    MazeCache::Entry* entry = m_mazeCache.get(path);
+    if (entry == nullptr) {
+        Maze* maze = loadMaze(path);
+        if (maze == nullptr) {
+            return false;
+        }
+        entry = m_mazeCache.insert(path, maze);
+    }
+    updateMaze(entry);
+    m_currentMazeFile = path;
+    SettingsMisc::setRecentMazeFile(path);
+    return true;
+}
+
+Maze* Window::loadMaze(QString path) {
+    Maze* maze = Maze::fromFile(path);
+    if (maze == nullptr) {
+        maze = MazeCorpus::fromReference(path);
+    }
+    return maze;
 }
 
 void Window::onColorButtonPressed() {
@@ -408,12 +483,16 @@ void Window::onColorButtonPressed() {
         dialog.getTileWallNotSetAlpha()
     );
 
-    // Redraw the "truth" view with the new colors
-    m_truth->getMazeGraphic()->refreshColors();
+    // Redraw the cached views with the new colors, so that later runs start
+    // with them too
+    for (MazeCache::Entry* entry : m_mazeCache.getEntries()) {
+        entry->truth->getMazeGraphic()->refreshColors();
+        entry->belief->getMazeGraphic()->refreshColors();
+    }
 
-    // Redraw the mouse's view with the new colors
-    if (m_view != nullptr) {
-        m_view->getMazeGraphic()->refreshColors();
+    // Redraw the mice's views with the new colors
+    for (MouseSession* session : m_sessions) {
+        session->getView()->getMazeGraphic()->refreshColors();
     }
 }
 
@@ -432,62 +511,66 @@ void Window::refreshMazeFileComboBox(QString selected) {
         m_mazeFileComboBox->addItem(info.absoluteFilePath());
     }
     for (const auto& path : SettingsMazeFiles::getAllPaths()) {
-        m_mazeFileComboBox->addItem(path);
+        MazeCorpus* corpus = MazeCorpus::open(path);
+        if (corpus == nullptr) {
+            m_mazeFileComboBox->addItem(path);
+            continue;
+        }
+
+        // Only the index is read, the mazes are loaded when selected
+        for (int i = 0; i < corpus->getCount(); i += 1) {
+            m_mazeFileComboBox->addItem(
+                MazeCorpus::getReference(path, corpus->getEntry(i).name));
+        }
+        delete corpus;
     }
+    m_mazeFileComboBox->addItem(GENERATE_MAZE_ENTRY);
     m_mazeFileComboBox->setCurrentText(selected);
 }
 
-void Window::updateMazeAndPath(Maze* maze, QString path) {
-    updateMaze(maze);
-    m_currentMazeFile = path;
-    SettingsMisc::setRecentMazeFile(path);
-}
-
-void Window::updateMaze(Maze* maze) {
+void Window::updateMaze(MazeCache::Entry* entry) {
 
     // Stop running maze/mouse algos
     cancelAllProcesses();
 
-    // Next, update the maze and truth
-    Maze* oldMaze = m_maze;
-    MazeView* oldTruth = m_truth;
-    m_maze = maze;
-    m_truth = new MazeView(m_maze, true);
+    // Next, update the maze, fields, and truth, whose text only needs to be
+    // written if it was last cached with a different overlay
+    m_mazeEntry = entry;
+    m_maze = entry->maze;
+    m_truth = entry->truth;
+    m_fieldEngine = entry->fieldEngine;
+    if (entry->overlay != m_overlayComboBox->currentIndex()) {
+        updateTruthOverlay();
+    }
 
-    // The truth has walls declared and distance as text
-    MazeGraphic* mazeGraphic = m_truth->getMazeGraphic();
-    for (int x = 0; x < m_maze->getWidth(); x += 1) {
-        for (int y = 0; y < m_maze->getHeight(); y += 1) {
-            const Tile* tile = m_maze->getTile(x, y);
-            for (Direction d : DIRECTIONS()) {
-                if (tile->isWall(d)) {
-                    mazeGraphic->setWall(x, y, d);
-                }
-            }
-            int distance = tile->getDistance();
-            QString text = 0 <= distance ? QString::number(distance) : "inf";
-            mazeGraphic->setText(x, y, text);
-        }
+    // Every mouse is scored against the best possible run in this maze
+    float optimalScore = m_fieldEngine->getOptimalScore();
+    for (Stats* stats : m_stats) {
+        stats->setOptimalScore(optimalScore);
     }
 
     // Update pointers held by other objects
     m_map->setMaze(m_maze);
     m_map->setView(m_truth);
 
-    // Delete the old objects
-    delete oldMaze;
-    delete oldTruth;
+    // Now that nothing refers to the other mazes, make room in the cache
+    m_mazeCache.trim();
 }
 
 void Window::onMouseAlgoComboBoxChanged(QString name) {
     cancelAllProcesses();
     m_buildStatus->setText("");
     m_buildStatus->setStyleSheet("");
-    m_buildOutput->clear();
+    m_buildOutput->reset();
     m_runStatus->setText("");
     m_runStatus->setStyleSheet("");
-    m_runOutput->clear();
-    stats->resetAll();
+    for (LogConsole* runOutput : m_runOutputs) {
+        runOutput->reset();
+    }
+    for (Stats* stats : m_stats) {
+        stats->resetAll();
+    }
+    refreshRaceMenu();
     SettingsMisc::setRecentMouseAlgo(name);
 }
 
@@ -562,6 +645,68 @@ void Window::refreshMouseAlgoComboBox(QString selected) {
     m_mouseAlgoEditButton->setEnabled(isNonempty);
     m_buildButton->setEnabled(isNonempty);
     m_runButton->setEnabled(isNonempty);
+
+    // Forget racing algos that no longer exist
+    for (const auto& name : m_raceAlgos.toList()) {
+        if (!SettingsMouseAlgos::names().contains(name)) {
+            m_raceAlgos.remove(name);
+        }
+    }
+    refreshRaceMenu();
+}
+
+void Window::onRaceAlgoToggled(QString name, bool checked) {
+    if (checked) {
+        m_raceAlgos.insert(name);
+    }
+    else {
+        m_raceAlgos.remove(name);
+    }
+    updateRaceButton();
+}
+
+void Window::refreshRaceMenu() {
+    m_raceMenu->clear();
+    QString selected = m_mouseAlgoComboBox->currentText();
+    for (const auto& name : SettingsMouseAlgos::names()) {
+        // The selected mouse algo always runs, it can't race itself
+        if (name == selected) {
+            continue;
+        }
+        QAction* action = m_raceMenu->addAction(name);
+        action->setCheckable(true);
+        action->setChecked(m_raceAlgos.contains(name));
+        connect(action, &QAction::toggled, this, [=](bool checked){
+            onRaceAlgoToggled(name, checked);
+        });
+    }
+    updateRaceButton();
+}
+
+void Window::updateRaceButton() {
+    // Don't allow more than MAX_MICE mice to be selected
+    int racers = getRunAlgos().size();
+    for (QAction* action : m_raceMenu->actions()) {
+        action->setEnabled(action->isChecked() || racers < MAX_MICE);
+    }
+    m_raceButton->setEnabled(!m_raceMenu->actions().isEmpty());
+    m_raceButton->setText(
+        racers <= 1 ? "Race" : QString("Race (%1)").arg(racers)
+    );
+}
+
+QStringList Window::getRunAlgos() const {
+    QString selected = m_mouseAlgoComboBox->currentText();
+    QStringList names = {selected};
+    for (const auto& name : SettingsMouseAlgos::names()) {
+        if (names.size() == MAX_MICE) {
+            break;
+        }
+        if (name != selected && m_raceAlgos.contains(name)) {
+            names.append(name);
+        }
+    }
+    return names;
 }
 
 void Window::cancelProcess(QProcess* process, QLabel* status) {
@@ -620,14 +765,18 @@ void Window::startBuild() {
         if (output.endsWith("\n")) {
             output.truncate(output.size() - 1);
         }
-        m_buildOutput->appendPlainText(output);
+        for (const QString& line : output.split("\n")) {
+            m_buildOutput->appendLine(line);
+        }
     });
     connect(process, &QProcess::readyReadStandardError, this, [=](){
         QString output = process->readAllStandardError();
         if (output.endsWith("\n")) {
             output.truncate(output.size() - 1);
         }
-        m_buildOutput->appendPlainText(output);
+        for (const QString& line : output.split("\n")) {
+            m_buildOutput->appendLine(line);
+        }
     });
 
     // Clean up on exit
@@ -641,7 +790,7 @@ void Window::startBuild() {
     );
 
     // Clear the ouput and bring it to the front
-    m_buildOutput->clear();
+    m_buildOutput->reset(LogConsole::logFilePath("build"));
     m_mouseAlgoOutputTabWidget->setCurrentWidget(m_buildOutput);
 
     // Start the build process
@@ -671,7 +820,7 @@ void Window::startBuild() {
     }
     else {
         // Clean up the failed process
-        m_buildOutput->appendPlainText(process->errorString());
+        m_buildOutput->appendLine(process->errorString());
         m_buildStatus->setText("ERROR");
         m_buildStatus->setStyleSheet(ERROR_STYLE_SHEET);
         delete process;
@@ -716,139 +865,145 @@ void Window::onBuildExit(int exitCode, QProcess::ExitStatus exitStatus) {
 
 void Window::startRun() {
 
-    // Only one algo running at a time
-    ASSERT_TR(m_runProcess == nullptr);
-
-    // Extract the relevant config
-    QString name = m_mouseAlgoComboBox->currentText();
-    QString directory = SettingsMouseAlgos::getDirectory(name);
-    QString runCommand = SettingsMouseAlgos::getRunCommand(name);
+    // Only one race at a time
+    ASSERT_FA(isRunning());
+
+    // Validate the config of every mouse in the race
+    QStringList names = getRunAlgos();
+    for (const auto& name : names) {
+        if (SettingsMouseAlgos::getDirectory(name).isEmpty()) {
+            QMessageBox::warning(
+                this,
+                "Empty Directory",
+                QString("Directory for \"%1\" is empty.").arg(
+                    name
+                )
+            );
+            return;
+        }
+        if (SettingsMouseAlgos::getRunCommand(name).isEmpty()) {
+            QMessageBox::warning(
+                this,
+                "Empty Run Command",
+                QString("Run command for \"%1\" is empty.").arg(
+                    name
+                )
+            );
+            return;
+        }
+    }
+    ASSERT_FA(m_maze == nullptr);
 
-    // Validation
-    if (directory.isEmpty()) {
-        QMessageBox::warning(
-            this,
-            "Empty Directory",
-            QString("Directory for \"%1\" is empty.").arg(
-                name
-            )
+    // Remove the old mice, add a session for each new mouse
+    removeMiceFromMaze();
+    QVector<const MouseGraphic*> mouseGraphics;
+    for (int i = 0; i < names.size(); i += 1) {
+        MouseSession* session = new MouseSession(
+            m_maze,
+            m_mazeEntry->belief,
+            m_stats.at(i),
+            m_runOutputs.at(i),
+            m_speedSlider,
+            i
         );
-        return;
-    }
-    if (runCommand.isEmpty()) {
-        QMessageBox::warning(
+        connect(session, &MouseSession::exited, this, &Window::onRunExit);
+        connect(
+            session,
+            &MouseSession::resetAcknowledged,
             this,
-            "Empty Run Command",
-            QString("Run command for \"%1\" is empty.").arg(
-                name
-            )
+            &Window::onResetAcknowledged
         );
-        return;
+        m_sessions.append(session);
+        mouseGraphics.append(session->getMouseGraphic());
     }
-    ASSERT_FA(m_maze == nullptr);
+    m_map->setMouseGraphics(mouseGraphics);
 
-    // Remove the old mouse, add a new mouse
-    removeMouseFromMaze();
-    m_mouse = new Mouse();
-    m_view = new MazeView(m_maze, false);
-    m_mouseGraphic = new MouseGraphic(m_mouse);
-    m_map->setView(m_view);
-    m_map->setMouseGraphic(m_mouseGraphic);
+    // Show the first mouse's view, output, and stats
+    refreshViewComboBox(names);
+    m_mouseAlgoOutputTabWidget->setCurrentWidget(m_runOutputStack);
 
-    // Instantiate a new process
-    QProcess* process = new QProcess();
-
-    // Print stderr
-    connect(process, &QProcess::readyReadStandardError, this, [=](){
-        QString output = process->readAllStandardError();
-        QStringList logs = processText(output, &m_logBuffer);
-        for (QString log : logs) {
-            m_runOutput->appendPlainText(log);
-        }
-    });
+    // Clear the ouputs and reset the scores
+    for (int i = 0; i < names.size(); i += 1) {
+        m_runOutputs.at(i)->reset(
+            LogConsole::logFilePath(QString("run-%1").arg(i)));
+        m_stats.at(i)->resetAll();
+    }
 
-    // Process commands from stdout
-    connect(process, &QProcess::readyReadStandardOutput, this, [=](){
-        QString output = process->readAllStandardOutput();
-        QStringList commands = processText(output, &m_commandBuffer);
-        for (QString command : commands) {
-            dispatchCommand(command);
+    // Start the run processes, all or nothing
+    for (int i = 0; i < names.size(); i += 1) {
+        bool started = m_sessions.at(i)->start(
+            SettingsMouseAlgos::getRunCommand(names.at(i)),
+            SettingsMouseAlgos::getDirectory(names.at(i))
+        );
+        if (!started) {
+            // Clean up the processes that did start, and show the error
+            for (MouseSession* session : m_sessions) {
+                disconnect(session, nullptr, this, nullptr);
+                session->cancel();
+            }
+            m_runStatus->setText("ERROR");
+            m_runStatus->setStyleSheet(ERROR_STYLE_SHEET);
+            removeMiceFromMaze();
+            m_runOutputStack->setCurrentIndex(i);
+            return;
         }
-    });
+    }
 
-    // Clean up on exit
+    // Update the run button
+    disconnect(
+        m_runButton,
+        &QPushButton::clicked,
+        this,
+        &Window::startRun
+    );
     connect(
-        process,
-        static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
-            &QProcess::finished
-        ),
+        m_runButton,
+        &QPushButton::clicked,
         this,
-        &Window::onRunExit
+        &Window::cancelRun
     );
+    m_runButton->setText("Cancel");
 
-    // Clear the ouput and bring it to the front
-    m_runOutput->clear();
-    m_mouseAlgoOutputTabWidget->setCurrentWidget(m_runOutput);
+    // Update the run status
+    m_runStatus->setText("RUNNING");
+    m_runStatus->setStyleSheet(IN_PROGRESS_STYLE_SHEET);
 
-    // reset score
-    stats->resetAll();
-
-    // Start the run process
-    if (ProcessUtilities::start(runCommand, directory, process)) {
-
-        // Save a pointer to the process
-        m_runProcess = process;
-
-        // Update the run button
-        disconnect(
-            m_runButton,
-            &QPushButton::clicked,
-            this,
-            &Window::startRun
-        );
-        connect(
-            m_runButton,
-            &QPushButton::clicked,
-            this,
-            &Window::cancelRun
-        );
-        m_runButton->setText("Cancel");
-
-        // Update the run status
-        m_runStatus->setText("RUNNING");
-        m_runStatus->setStyleSheet(IN_PROGRESS_STYLE_SHEET);
-
-        // Only enabled while mouse is running
-        m_pauseButton->setEnabled(true);
-        m_resetButton->setEnabled(true);
-    } 
-    else {
-        // Clean up the failed process
-        m_runOutput->appendPlainText(process->errorString());
-        m_runStatus->setText("ERROR");
-        m_runStatus->setStyleSheet(ERROR_STYLE_SHEET);
-        removeMouseFromMaze();
-        delete process;
-    }
+    // Only enabled while mice are running
+    m_pauseButton->setEnabled(true);
+    m_resetButton->setEnabled(true);
 }
 
 void Window::cancelRun() {
-    cancelProcess(m_runProcess, m_runStatus);
-    removeMouseFromMaze();
+    if (isRunning()) {
+        for (MouseSession* session : m_sessions) {
+            session->cancel();
+        }
+        m_runStatus->setText("CANCELED");
+        m_runStatus->setStyleSheet(CANCELED_STYLE_SHEET);
+    }
+    removeMiceFromMaze();
 }
 
-void Window::onRunExit(int exitCode, QProcess::ExitStatus exitStatus) {
+void Window::onRunExit() {
+
+    // A mouse that exits can no longer acknowledge a pending reset, so the
+    // reset may now be complete for the mice that are still running
+    onResetAcknowledged();
+
+    // The race is over once the last mouse exits
+    if (isRunning()) {
+        return;
+    }
 
     // Always unpause on exit
     if (m_isPaused) {
         onPauseButtonPressed();
     }
 
-    // Only enabled while mouse is running
+    // Only enabled while mice are running
     m_pauseButton->setEnabled(false);
     m_resetButton->setEnabled(false);
     m_resetButton->setText("Reset");
-    m_wasReset = false;
 
     // Update the run button
     disconnect(
@@ -865,8 +1020,12 @@ void Window::onRunExit(int exitCode, QProcess::ExitStatus exitStatus) {
     );
     m_runButton->setText("Run");
 
-    // Update the status label
-    if (exitStatus == QProcess::NormalExit && exitCode == 0) {
+    // Update the status label, the race only succeeds if every mouse does
+    bool success = true;
+    for (MouseSession* session : m_sessions) {
+        success = success && session->exitedNormally();
+    }
+    if (success) {
         m_runStatus->setText("COMPLETE");
         m_runStatus->setStyleSheet(COMPLETE_STYLE_SHEET);
     }
@@ -874,500 +1033,149 @@ void Window::onRunExit(int exitCode, QProcess::ExitStatus exitStatus) {
         m_runStatus->setText("FAILED");
         m_runStatus->setStyleSheet(FAILED_STYLE_SHEET);
     }
+}
 
-    // Clean up (stop producing commands)
-    delete m_runProcess;
-    m_runProcess = nullptr;
-
-    // Stop consuming queued commands
-    m_commandQueueTimer->stop();
-    m_commandQueue.clear();
+bool Window::isRunning() const {
+    for (MouseSession* session : m_sessions) {
+        if (session->isRunning()) {
+            return true;
+        }
+    }
+    return false;
 }
 
-void Window::removeMouseFromMaze() {
+void Window::removeMiceFromMaze() {
 
-    // No-op if no mouse
-    if (m_mouse == nullptr) {
+    // No-op if no mice
+    if (m_sessions.isEmpty()) {
         return;
     }
 
     // Update some objects
     m_map->setView(m_truth);
-    m_map->setMouseGraphic(nullptr);
-
-    // Delete some objects
-    ASSERT_FA(m_view == nullptr);
-    ASSERT_FA(m_mouseGraphic == nullptr);
-    delete m_mouse;
-    m_mouse = nullptr;
-    delete m_view;
-    m_view = nullptr;
-    delete m_mouseGraphic;
-    m_mouseGraphic = nullptr;
-
-    // Reset communication state
-    m_logBuffer.clear();
-    m_commandBuffer.clear();
-
-    // Reset movement state
-    m_startingLocation = {0, 0};
-    m_startingDirection = Direction::NORTH;
-    m_movement = Movement::NONE;
-    m_movementProgress = 0.0;
-    m_movementStepSize = 0.0;
-
-    // Reset other mouse state
-    m_tilesWithColor.clear();
-    m_tilesWithText.clear();
+    m_map->setMouseGraphics({});
+
+    // Delete the sessions, which own the mice and their views
+    for (MouseSession* session : m_sessions) {
+        delete session;
+    }
+    m_sessions.clear();
+    refreshViewComboBox({});
 }
 
-void Window::onPauseButtonPressed() {
-    m_isPaused = !m_isPaused;
-    if (m_isPaused) {
-        m_pauseButton->setText("Resume");
-        m_runStatus->setText("PAUSED");
+void Window::onViewComboBoxChanged(int index) {
+    if (index < 0) {
+        return;
+    }
+    // Index zero is the truth, followed by each of the mice
+    if (index == 0) {
+        m_map->setView(m_truth);
     }
     else {
-        m_pauseButton->setText("Pause");
-        m_runStatus->setText("RUNNING");
-        processQueuedCommands();
+        ASSERT_LE(index, m_sessions.size());
+        m_map->setView(m_sessions.at(index - 1)->getView());
+        m_runOutputStack->setCurrentIndex(index - 1);
+        m_statsStack->setCurrentIndex(index - 1);
     }
 }
 
-void Window::onResetButtonPressed() {
-    m_resetButton->setEnabled(false);
-    m_resetButton->setText("Waiting");
-    m_wasReset = true;
+void Window::refreshViewComboBox(QStringList names) {
+    m_viewComboBox->blockSignals(true);
+    m_viewComboBox->clear();
+    m_viewComboBox->addItem("Truth");
+    for (int i = 0; i < names.size(); i += 1) {
+        m_viewComboBox->addItem(QString("Mouse %1: %2").arg(i + 1).arg(
+            names.at(i)
+        ));
+    }
+    m_viewComboBox->setEnabled(!names.isEmpty());
+    m_viewComboBox->blockSignals(false);
+
+    // Prefer the first mouse's view, if there is one
+    m_viewComboBox->setCurrentIndex(names.isEmpty() ? 0 : 1);
+    onViewComboBoxChanged(m_viewComboBox->currentIndex());
 }
 
-QStringList Window::processText(QString text, QStringList* buffer) {
-
-    QStringList lines;
-
-    // Separate the text by line
-    text.replace("\r", "");  // Windows compatibility
-    QStringList parts = text.split("\n");
-
-    // If the text has at least one newline character, we definitely have a
-    // complete line; combine it with the contents of the buffer and append
-    // it to the list of lines to be returned
-    if (1 < parts.size()) {
-        lines.append(buffer->join("") + parts.at(0));
-        buffer->clear();
-    }
-
-    // All newline-separated parts in the text are lines
-    for (int i = 1; i < parts.size() - 1; i += 1) {
-        lines.append(parts.at(i));
+void Window::onOverlayComboBoxChanged(int index) {
+    if (index < 0 || m_truth == nullptr) {
+        return;
     }
-
-    // Store the last part of the text (empty string if the text ended
-    // with newline) in the buffer, to be combined with future input
-    buffer->append(parts.at(parts.size() - 1));
-
-    return lines;
+    updateTruthOverlay();
 }
 
-void Window::dispatchCommand(QString command) {
-
-    // For performance reasons, handle no-response commands inline (don't queue
-    // them with the commands that elicit a response, just perform the action)
-    if (
-        command.startsWith("setWall") ||
-        command.startsWith("clearWall")
-    ) {
-        QStringList tokens = command.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() != 4) {
-            return;
-        }
-        if (!(tokens.at(0) == "setWall" || tokens.at(0) == "clearWall")) {
-            return;
-        }
-        bool ok = true;
-        int x = tokens.at(1).toInt(&ok);
-        int y = tokens.at(2).toInt(&ok);
-        if (!ok) {
-            return;
-        }
-        if (tokens.at(3).size() != 1) {
-            return;
-        }
-        QChar direction = tokens.at(3).at(0);
-        if (!CHAR_TO_DIRECTION().contains(direction)) {
-            return;
-        }
-        if (command.startsWith("setWall")) {
-            setWall(x, y, direction);
-        }
-        else if (command.startsWith("clearWall")) {
-            clearWall(x, y, direction);
-        }
-        else {
-            ASSERT_NEVER_RUNS();
-        }
-    }
-    else if (command.startsWith("setColor")) {
-        QStringList tokens = command.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() != 4) {
-            return;
-        }
-        if (tokens.at(0) != "setColor") {
-            return;
-        }
-        bool ok = true;
-        int x = tokens.at(1).toInt(&ok);
-        int y = tokens.at(2).toInt(&ok);
-        if (!ok) {
-            return;
-        }
-        if (tokens.at(3).size() != 1) {
-            return;
-        }
-        QChar color = tokens.at(3).at(0);
-        if (!CHAR_TO_COLOR().contains(color)) {
-            return;
-        }
-        setColor(x, y, color);
-    }
-    else if (command.startsWith("clearColor")) {
-        QStringList tokens = command.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() != 3) {
-            return;
-        }
-        if (tokens.at(0) != "clearColor") {
-            return;
-        }
-        bool ok = true;
-        int x = tokens.at(1).toInt(&ok);
-        int y = tokens.at(2).toInt(&ok);
-        if (!ok) {
-            return;
-        }
-        clearColor(x, y);
-    }
-    else if (command.startsWith("clearAllColor")) {
-        QStringList tokens = command.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() != 1) {
-            return;
-        }
-        if (tokens.at(0) != "clearAllColor") {
-            return;
-        }
-        clearAllColor();
-    }
-    else if (command.startsWith("setText")) {
-        // Special parsing to allow space characters in the text
-        int firstSpace = command.indexOf(" ");
-        int secondSpace = command.indexOf(" ", firstSpace + 1);
-        int thirdSpace = command.indexOf(" ", secondSpace + 1);
-        QString function = command.left(firstSpace);
-        if (function != "setText") {
-            return;
-        }
-        QString xString = command.mid(firstSpace + 1, secondSpace - firstSpace);
-        QString yString = command.mid(secondSpace + 1, thirdSpace - secondSpace);
-        bool ok = true;
-        int x = xString.toInt(&ok);
-        int y = yString.toInt(&ok);
-        if (!ok) {
-            return;
-        }
-        QString text = command.mid(thirdSpace + 1);
-        setText(x, y, text);
-    }
-    else if (command.startsWith("clearText")) {
-        QStringList tokens = command.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() != 3) {
-            return;
-        }
-        if (tokens.at(0) != "clearText") {
-            return;
-        }
-        bool ok = true;
-        int x = tokens.at(1).toInt(&ok);
-        int y = tokens.at(2).toInt(&ok);
-        if (!ok) {
-            return;
-        }
-        clearText(x, y);
-    }
-    else if (command.startsWith("clearAllText")) {
-        QStringList tokens = command.split(" ", QString::SkipEmptyParts);
-        if (tokens.size() != 1) {
-            return;
-        }
-        if (tokens.at(0) != "clearAllText") {
-            return;
-        }
-        clearAllText();
-    }
-    else {
-        // Enqueue the serial command, process it if
-        // future processing is not already scheduled
-        m_commandQueue.enqueue(command);
-        if (!m_commandQueueTimer->isActive()) {
-            processQueuedCommands();
+void Window::updateTruthOverlay() {
+    Field field = FIELDS().at(m_overlayComboBox->currentIndex());
+    m_mazeEntry->overlay = m_overlayComboBox->currentIndex();
+    MazeGraphic* mazeGraphic = m_truth->getMazeGraphic();
+    for (int x = 0; x < m_maze->getWidth(); x += 1) {
+        for (int y = 0; y < m_maze->getHeight(); y += 1) {
+            mazeGraphic->setText(x, y, m_fieldEngine->getText(field, x, y));
         }
     }
 }
 
-QString Window::executeCommand(QString command) {
-    QStringList tokens = command.split(" ", QString::SkipEmptyParts);
-    if (tokens.size() < 1 || tokens.size() > 2) {
-        return INVALID;
-    }
-    QString function = tokens.at(0);
-    if (tokens.size() == 2 &&
-            !(function == "moveForward" || function == "getStat")) {
-        return INVALID;
-    }
-    if (function == "mazeWidth") {
-        return QString::number(mazeWidth());
-    }
-    else if (function == "mazeHeight") {
-        return QString::number(mazeHeight());
-    }
-    else if (function == "wallFront") {
-        return boolToString(wallFront(0));
-    }
-    else if (function == "wallRight") {
-        return boolToString(wallRight());
-    }
-    else if (function == "wallLeft") {
-        return boolToString(wallLeft());
-    }
-    else if (function == "moveForward") {
-        int distance = 1;
-        if (tokens.size() == 2) {
-            distance = tokens.at(1).toInt();
-        }
-        bool success = moveForward(distance);
-        return success ? "" : CRASH;
-    }
-    else if (function == "turnRight") {
-        turnRight();
-        return "";
-    }
-    else if (function == "turnLeft") {
-        turnLeft();
-        return "";
-    }
-    else if (function == "wasReset") {
-        return boolToString(wasReset());
-    }
-    else if (function == "ackReset") {
-        ackReset();
-        return ACK;
-    }
-    else if (function == "getStat") {
-        if (tokens.size() != 2) {
-            return INVALID;
-        }
-        QString stat = tokens.at(1);
-        // Convert stat to a StatsEnum
-        StatsEnum statsEnum;
-        if (stat == "total-distance") {
-            statsEnum = StatsEnum::TOTAL_DISTANCE;
-        }
-        else if (stat == "total-turns") {
-            statsEnum = StatsEnum::TOTAL_TURNS;
-        }
-        else if (stat == "best-run-distance") {
-            statsEnum = StatsEnum::BEST_RUN_DISTANCE;
-        }
-        else if (stat == "best-run-turns") {
-            statsEnum = StatsEnum::BEST_RUN_TURNS;
-        }
-        else if (stat == "current-run-distance") {
-            statsEnum = StatsEnum::CURRENT_RUN_DISTANCE;
-        }
-        else if (stat == "current-run-turns") {
-            statsEnum = StatsEnum::CURRENT_RUN_TURNS;
-        }
-        else if (stat == "total-effective-distance") {
-            statsEnum = StatsEnum::TOTAL_EFFECTIVE_DISTANCE;
-        }
-        else if (stat == "best-run-effective-distance") {
-            statsEnum = StatsEnum::BEST_RUN_EFFECTIVE_DISTANCE;
-        }
-        else if (stat == "current-run-effective-distance") {
-            statsEnum = StatsEnum::CURRENT_RUN_EFFECTIVE_DISTANCE;
-        }
-        else if (stat == "score") {
-            statsEnum = StatsEnum::SCORE;
-        }
-        else {
-            return INVALID;
-        }
-        QString statValue = stats->getStat(statsEnum);
-        if (statValue == "") {
-            // Cannot return an empty string. Return -1 to indicate empty field.
-            return "-1";
-        }
-        return statValue;
+void Window::onPauseButtonPressed() {
+    m_isPaused = !m_isPaused;
+    if (m_isPaused) {
+        m_pauseButton->setText("Resume");
+        m_runStatus->setText("PAUSED");
     }
     else {
-        return INVALID;
+        m_pauseButton->setText("Pause");
+        m_runStatus->setText("RUNNING");
     }
-}
-
-void Window::processQueuedCommands() {
-    while (!m_commandQueue.isEmpty() && !m_isPaused) {
-        QString response = "";
-        if (isMoving()) {
-            updateMouseProgress(m_movementStepSize);
-            if (!isMoving()) {
-                if (m_doomedToCrash) {
-                    response = CRASH;
-                }
-                else {
-                    response = ACK;
-                }
-            }
-        }
-        else {
-            response = executeCommand(m_commandQueue.head());
-        }
-        if (!response.isEmpty()) {
-            // Drop all invalid commands on the floor
-            if (response != INVALID) {
-                m_runProcess->write((response + "\n").toStdString().c_str());
-            }
-            m_commandQueue.dequeue();
-        }
-        else {
-            scheduleMouseProgressUpdate();
-            break;
-        }
+    for (MouseSession* session : m_sessions) {
+        session->setPaused(m_isPaused);
     }
 }
 
-double Window::progressRequired(Movement movement) {
-    switch (movement) {
-        case Movement::MOVE_FORWARD:
-            return PROGRESS_REQUIRED_FOR_MOVE;
-        case Movement::TURN_RIGHT:
-        case Movement::TURN_LEFT:
-            return PROGRESS_REQUIRED_FOR_TURN;
-        default:
-            ASSERT_NEVER_RUNS();
+void Window::onResetButtonPressed() {
+    m_resetButton->setEnabled(false);
+    m_resetButton->setText("Waiting");
+    for (MouseSession* session : m_sessions) {
+        if (session->isRunning()) {
+            session->requestReset();
+        }
     }
 }
 
-void Window::updateMouseProgress(double progress) {
-
-    // Determine the destination of the mouse.
-    QPair<int, int> destinationLocation = m_startingLocation;
-    Angle destinationRotation =
-        DIRECTION_TO_ANGLE().value(m_startingDirection);
-    if (m_movement == Movement::MOVE_FORWARD) {
-        if (m_startingDirection == Direction::NORTH) {
-            destinationLocation.second += 1;
-        }
-        else if (m_startingDirection == Direction::EAST) {
-            destinationLocation.first += 1;
-        }
-        else if (m_startingDirection == Direction::SOUTH) {
-            destinationLocation.second -= 1;
-        }
-        else if (m_startingDirection == Direction::WEST) {
-            destinationLocation.first -= 1;
-        }
-        else {
-            ASSERT_NEVER_RUNS();
-        }
-    }
-    // Explicity add or subtract 90 degrees so that the mouse is guaranteed to
-    // only rotate 90 degrees (using DIRECTION_ROTATE can cause the mouse to
-    // rotate 270 degrees in the opposite direction in some cases)
-    else if (m_movement == Movement::TURN_RIGHT) {
-        destinationRotation -= Angle::Degrees(90);
-    }
-    else if (m_movement == Movement::TURN_LEFT) {
-        destinationRotation += Angle::Degrees(90);
-    }
-    else {
-        ASSERT_NEVER_RUNS();
-    }
-
-    // Increment the movement progress, calculate fraction complete
-    m_movementProgress += progress;
-    double required = progressRequired(m_movement);
-    double remaining = required - m_movementProgress;
-    if (remaining < 0) {
-        remaining = 0;
-    }
-    double fraction = 1.0 - (remaining / required);
-
-    // Calculate the current translation and rotation
-    Coordinate startingTranslation =
-        getCenterOfTile(m_startingLocation.first, m_startingLocation.second);
-    Coordinate destinationTranslation =
-        getCenterOfTile(destinationLocation.first, destinationLocation.second);
-    Angle startingRotation =
-        DIRECTION_TO_ANGLE().value(m_startingDirection);
-    Coordinate currentTranslation =
-        startingTranslation * (1.0 - fraction) +
-        destinationTranslation * fraction;
-    Angle currentRotation =
-        startingRotation * (1.0 - fraction) +
-        destinationRotation * fraction;
-
-    // Teleport the mouse, reset movement state if done
-    m_mouse->teleport(currentTranslation, currentRotation);
-    if (remaining == 0.0) {
-        m_startingLocation = m_mouse->getCurrentDiscretizedTranslation();
-        m_startingDirection = m_mouse->getCurrentDiscretizedRotation();
-        m_movementProgress = 0.0;
-        m_movementStepSize = 0.0;
-        if (m_movement == Movement::MOVE_FORWARD) {
-            m_movesRemaining -= 1;
-        }
-        if (m_movesRemaining == 0) {
-            m_movement = Movement::NONE;
-        }
-        // determine if the goal was reached
-        if (m_maze->isInCenter(m_startingLocation)) {
-            stats->finishRun(); // record a completed start-to-finish run
-        }
-        else if (m_startingLocation.first == 0 && m_startingLocation.second == 0) {
-            stats->endUnfinishedRun();
+void Window::onResetAcknowledged() {
+    // Wait for every running mouse to acknowledge the reset
+    for (MouseSession* session : m_sessions) {
+        if (session->isRunning() && session->isWaitingForReset()) {
+            return;
         }
     }
+    m_resetButton->setEnabled(true);
+    m_resetButton->setText("Reset");
 }
 
-void Window::scheduleMouseProgressUpdate() {
-    
-    // Calculate progressRemaining, should be nonzero
-    double required = progressRequired(m_movement);
-    double progressRemaining = required - m_movementProgress;
-    ASSERT_LT(0.0, progressRemaining);
-
-    // Calculate progressPerSecond for non-linear slider
-    double value = static_cast<double>(m_speedSlider->value());
-    double fraction = value / SPEED_SLIDER_MAX;
-    double rangeMin = qPow(MIN_PROGRESS_PER_SECOND, .25);
-    double rangeMax = qPow(MAX_PROGRESS_PER_SECOND, .25);
-    double rangeValue = (1.0 - fraction) * rangeMin + fraction * rangeMax;
-    double progressPerSecond = qPow(rangeValue, 4);
-
-    // Determine seconds remaing
-    double secondsRemaining = progressRemaining / progressPerSecond;
-    if (secondsRemaining > MAX_SLEEP_SECONDS) {
-        secondsRemaining = MAX_SLEEP_SECONDS;
-        progressRemaining = secondsRemaining * progressPerSecond;
-    }
-
-    // Update step size, set the timer
-    m_movementStepSize = progressRemaining;
-    m_commandQueueTimer->start(secondsRemaining * 1000);
-}
-
-bool Window::isMoving() {
-    return m_movement != Movement::NONE;
+QWidget* Window::createStatsWidget(Stats* stats) {
+    QWidget* statsWidget = new QWidget();
+    QGridLayout* statsLayout = new QGridLayout();
+    statsWidget->setLayout(statsLayout);
+    createStat(stats, "Total Distance", StatsEnum::TOTAL_DISTANCE, 0, 0, 0, 1, statsLayout);
+    createStat(stats, "Total Effective Distance", StatsEnum::TOTAL_EFFECTIVE_DISTANCE, 1, 0, 1, 1, statsLayout);
+    createStat(stats, "Total Turns", StatsEnum::TOTAL_TURNS, 2, 0, 2, 1, statsLayout);
+    createStat(stats, "Current Run Distance", StatsEnum::CURRENT_RUN_DISTANCE, 0, 2, 0, 3, statsLayout);
+    createStat(stats, "Current Run Effective Distance", StatsEnum::CURRENT_RUN_EFFECTIVE_DISTANCE, 1, 2, 1, 3, statsLayout);
+    createStat(stats, "Current Run Turns", StatsEnum::CURRENT_RUN_TURNS, 2, 2, 2, 3, statsLayout);
+    createStat(stats, "Best Run Distance", StatsEnum::BEST_RUN_DISTANCE, 3, 0, 3, 1, statsLayout);
+    createStat(stats, "Best Run Effective Distance", StatsEnum::BEST_RUN_EFFECTIVE_DISTANCE, 4, 0, 4, 1, statsLayout);
+    createStat(stats, "Best Run Turns", StatsEnum::BEST_RUN_TURNS, 5, 0, 5, 1, statsLayout);
+    createStat(stats, "Score", StatsEnum::SCORE, 6, 0, 6, 1, statsLayout);
+    createStat(stats, "Optimal Score", StatsEnum::OPTIMAL_SCORE, 3, 2, 3, 3, statsLayout);
+    createStat(stats, "% of Optimal", StatsEnum::PERCENT_OF_OPTIMAL, 4, 2, 4, 3, statsLayout);
+    createStat(stats, "Queued Commands", StatsEnum::QUEUE_DEPTH, 5, 2, 5, 3, statsLayout);
+    createStat(stats, "Queue Time (ms)", StatsEnum::QUEUE_TIME, 6, 2, 6, 3, statsLayout);
+    createStat(stats, "CPU User Time (ms)", StatsEnum::CPU_USER_TIME, 7, 0, 7, 1, statsLayout);
+    createStat(stats, "CPU System Time (ms)", StatsEnum::CPU_SYSTEM_TIME, 8, 0, 8, 1, statsLayout);
+    createStat(stats, "CPU Time per Move (ms)", StatsEnum::CPU_TIME_PER_MOVE, 7, 2, 7, 3, statsLayout);
+    createStat(stats, "Peak Memory (MB)", StatsEnum::PEAK_MEMORY, 8, 2, 8, 3, statsLayout);
+    return statsWidget;
 }
 
-void Window::createStat(QString name, enum StatsEnum stat, int labelRow, int labelCol, int valueRow, int valueCol, QGridLayout* layout) {
+void Window::createStat(Stats* stats, QString name, enum StatsEnum stat, int labelRow, int labelCol, int valueRow, int valueCol, QGridLayout* layout) {
     QLabel* label = new QLabel(name);
     layout->addWidget(label, labelRow, labelCol);
     QLineEdit* textbox = new QLineEdit();
@@ -1376,235 +1184,4 @@ void Window::createStat(QString name, enum StatsEnum stat, int labelRow, int lab
     layout->addWidget(textbox, valueRow, valueCol);
 }
 
-int Window::mazeWidth() {
-    return m_maze->getWidth();
-}
-
-int Window::mazeHeight() {
-    return m_maze->getHeight();
-}
-
-bool Window::wallFront(int distance) {
-    QPair<int, int> position = m_mouse->getCurrentDiscretizedTranslation();
-    Direction direction = m_mouse->getCurrentDiscretizedRotation();
-    switch (direction) {
-        case Direction::NORTH:
-            position.second += distance;
-            break;
-        case Direction::SOUTH:
-            position.second -= distance;
-            break;
-        case Direction::EAST:
-            position.first += distance;
-            break;
-        case Direction::WEST:
-            position.first -= distance;
-            break;
-    }
-    return isWall({position.first, position.second, direction});
-}
-
-bool Window::wallRight() {
-    QPair<int, int> position = m_mouse->getCurrentDiscretizedTranslation();
-    Direction direction =
-        DIRECTION_ROTATE_RIGHT().value(m_mouse->getCurrentDiscretizedRotation());
-    return isWall({position.first, position.second, direction});
-}
-
-bool Window::wallLeft() {
-    QPair<int, int> position = m_mouse->getCurrentDiscretizedTranslation();
-    Direction direction =
-        DIRECTION_ROTATE_LEFT().value(m_mouse->getCurrentDiscretizedRotation());
-    return isWall({position.first, position.second, direction});
-}
-
-bool Window::moveForward(int distance) {
-    // Non-positive distances aren't allowed
-    if (distance < 1) {
-        return false;
-    }
-    // Special case for a wall directly in front of the mouse, else
-    // the wall won't be detected until after the mouse starts moving
-    if (wallFront(0)) {
-        return false;
-    }
-    // Compute the number of allowable moves
-    int moves = 1;
-    while (moves < distance) {
-        if (wallFront(moves)) {
-            break;
-        }
-        moves += 1;
-    }
-    m_movement = Movement::MOVE_FORWARD;
-    m_doomedToCrash = (moves != distance);
-    m_movesRemaining = moves;
-    if (m_startingLocation.first == 0 && m_startingLocation.second == 0) {
-        stats->startRun();
-    }
-    // increase the stats by the distance that will be travelled
-    stats->addDistance(moves);
-    return true;
-}
-
-void Window::turnRight() {
-    m_movement = Movement::TURN_RIGHT;
-    m_doomedToCrash = false;
-    m_movesRemaining = 0;
-    stats->addTurn();
-}
-
-void Window::turnLeft() {
-    m_movement = Movement::TURN_LEFT;
-    m_doomedToCrash = false;
-    m_movesRemaining = 0;
-    stats->addTurn();
-}
-
-void Window::setWall(int x, int y, QChar direction) {
-    if (!isWithinMaze(x, y)) {
-        return;
-    }
-    if (!CHAR_TO_DIRECTION().contains(direction)) {
-        return;
-    }
-    Direction d = CHAR_TO_DIRECTION().value(direction);
-    m_view->getMazeGraphic()->setWall(x, y, d);
-    Wall opposingWall = getOpposingWall({x, y, d});
-    if (isWithinMaze(opposingWall.x, opposingWall.y)) {
-        m_view->getMazeGraphic()->setWall(
-            opposingWall.x,
-            opposingWall.y,
-            opposingWall.d
-        ); 
-    }
-}
-
-void Window::clearWall(int x, int y, QChar direction) {
-    if (!isWithinMaze(x, y)) {
-        return;
-    }
-    if (!CHAR_TO_DIRECTION().contains(direction)) {
-        return;
-    }
-    Direction d = CHAR_TO_DIRECTION().value(direction);
-    m_view->getMazeGraphic()->clearWall(x, y, d);
-    Wall opposingWall = getOpposingWall({x, y, d});
-    if (isWithinMaze(opposingWall.x, opposingWall.y)) {
-        m_view->getMazeGraphic()->clearWall(
-            opposingWall.x,
-            opposingWall.y,
-            opposingWall.d
-        ); 
-    }
-}
-
-void Window::setColor(int x, int y, QChar color) {
-    if (!isWithinMaze(x, y)) {
-        return;
-    }
-    if (!CHAR_TO_COLOR().contains(color)) {
-        return;
-    }
-    m_view->getMazeGraphic()->setColor(x, y, CHAR_TO_COLOR().value(color));
-    m_tilesWithColor.insert({x, y});
-}
-
-void Window::clearColor(int x, int y) {
-    if (!isWithinMaze(x, y)) {
-        return;
-    }
-    m_view->getMazeGraphic()->clearColor(x, y);
-    m_tilesWithColor -= {x, y};
-}
-
-void Window::clearAllColor() {
-    for (QPair<int, int> position : m_tilesWithColor) {
-        m_view->getMazeGraphic()->clearColor(position.first, position.second);
-    }
-    m_tilesWithColor.clear();
-}
-
-void Window::setText(int x, int y, QString text) {
-    if (!isWithinMaze(x, y)) {
-        return;
-    }
-    static QRegExp regex = QRegExp(
-        QString("[^") + FontImage::characters() + QString("]")
-    );
-    text.replace(regex, "?");
-    m_view->getMazeGraphic()->setText(x, y, text);
-    m_tilesWithText.insert({x, y});
-}
-
-void Window::clearText(int x, int y) {
-    if (!isWithinMaze(x, y)) {
-        return;
-    }
-    m_view->getMazeGraphic()->clearText(x, y);
-    m_tilesWithText -= {x, y};
-}
-
-void Window::clearAllText() {
-    for (QPair<int, int> position : m_tilesWithText) {
-        m_view->getMazeGraphic()->clearText(position.first, position.second);
-    }
-    m_tilesWithText.clear();
-}
-
-bool Window::wasReset() {
-    return m_wasReset;
-}
-
-void Window::ackReset() {
-    m_mouse->reset();
-    m_startingLocation = {0, 0};
-    m_startingDirection = Direction::NORTH;
-    m_movement = Movement::NONE;
-    m_movementProgress = 0.0;
-    m_movementStepSize = 0.0;
-    m_resetButton->setEnabled(true);
-    m_resetButton->setText("Reset");
-    m_wasReset = false;
-    stats->penalizeForReset();
-    stats->endUnfinishedRun();
-}
-
-QString Window::boolToString(bool value) const {
-    return value ? "true" : "false";
-}
-
-bool Window::isWall(Wall wall) const {
-    return m_maze->getTile(wall.x, wall.y)->isWall(wall.d);
-}
-
-bool Window::isWithinMaze(int x, int y) const {
-    return (
-        0 <= x && x < m_maze->getWidth() &&
-        0 <= y && y < m_maze->getHeight()
-    );
-}
-
-Wall Window::getOpposingWall(Wall wall) const {
-    switch (wall.d) {
-        case Direction::NORTH:
-            return {wall.x, wall.y + 1, Direction::SOUTH};
-        case Direction::EAST:
-            return {wall.x + 1, wall.y, Direction::WEST};
-        case Direction::SOUTH:
-            return {wall.x, wall.y - 1, Direction::NORTH};
-        case Direction::WEST:
-            return {wall.x - 1, wall.y, Direction::EAST};
-    }
-}
-
-Coordinate Window::getCenterOfTile(int x, int y) const {
-    ASSERT_TR(isWithinMaze(x, y));
-    Coordinate centerOfTile = Coordinate::Cartesian(
-        Dimensions::tileLength() * (static_cast<double>(x) + 0.5),
-        Dimensions::tileLength() * (static_cast<double>(y) + 0.5)
-    );
-    return centerOfTile;
-}
-
 } 
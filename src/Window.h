@@ -1,42 +1,30 @@
 #pragma once
 
-#include <QChar>
 #include <QCloseEvent>
 #include <QComboBox>
 #include <QLabel>
 #include <QMainWindow>
-#include <QPair>
-#include <QPlainTextEdit>
+#include <QMenu>
 #include <QProcess>
 #include <QPushButton>
-#include <QQueue>
 #include <QSet>
-#include <QTimer>
+#include <QSlider>
+#include <QStackedWidget>
 #include <QToolButton>
 #include <QGridLayout>
+#include <QVector>
 
+#include "FieldEngine.h"
+#include "LogConsole.h"
 #include "Map.h"
 #include "Maze.h"
+#include "MazeCache.h"
 #include "MazeView.h"
-#include "Mouse.h"
-#include "MouseGraphic.h"
+#include "MouseSession.h"
 #include "Stats.h"
 
 namespace mms {
 
-enum class Movement {
-    MOVE_FORWARD,
-    TURN_RIGHT,
-    TURN_LEFT,
-    NONE,
-};
-
-struct Wall {
-    int x;
-    int y;
-    Direction d;
-};
-
 class Window : public QMainWindow {
 
     Q_OBJECT
@@ -56,17 +44,28 @@ private:
 
     // ----- Maze -----
 
+    // The maze, truth, and fields are those of the entry, which the cache
+    // owns; the entry is always the cache's most recently used one
+    MazeCache m_mazeCache;
+    MazeCache::Entry* m_mazeEntry;
     Maze* m_maze;
     MazeView* m_truth;
+    FieldEngine* m_fieldEngine;
     QString m_currentMazeFile;
     QComboBox* m_mazeFileComboBox;
 
+    // Choosing this entry generates a new maze, every time
+    static const QString GENERATE_MAZE_ENTRY;
+    static const int GENERATED_MAZE_SIZE;
+
     void onMazeFileButtonPressed();
     void onMazeFileComboBoxChanged(QString path);
+    void generateMaze();
+    bool showMaze(QString path);
+    Maze* loadMaze(QString path);
     void showInvalidMazeFileWarning(QString path);
     void refreshMazeFileComboBox(QString selected);
-    void updateMazeAndPath(Maze* maze, QString path);
-    void updateMaze(Maze* maze);
+    void updateMaze(MazeCache::Entry* entry);
 
     // ----- Colors -----
 
@@ -82,6 +81,21 @@ private:
     void onMouseAlgoImportButtonPressed();
     void refreshMouseAlgoComboBox(QString selected);
 
+    // ----- Race config -----
+
+    // The maximum number of mice that can run in the maze at once
+    static const int MAX_MICE;
+
+    // Algos that race against the selected mouse algo
+    QToolButton* m_raceButton;
+    QMenu* m_raceMenu;
+    QSet<QString> m_raceAlgos;
+
+    void onRaceAlgoToggled(QString name, bool checked);
+    void refreshRaceMenu();
+    void updateRaceButton();
+    QStringList getRunAlgos() const;
+
     // ----- Algo processes-----
 
     static const QString IN_PROGRESS_STYLE_SHEET;
@@ -91,8 +105,14 @@ private:
     static const QString ERROR_STYLE_SHEET;
 
     QTabWidget* m_mouseAlgoOutputTabWidget;
-    QPlainTextEdit* m_buildOutput;
-    QPlainTextEdit* m_runOutput;
+    LogConsole* m_buildOutput;
+
+    // One run output and one set of stats per mouse slot,
+    // only the selected mouse's widgets are shown
+    QStackedWidget* m_runOutputStack;
+    QVector<LogConsole*> m_runOutputs;
+    QStackedWidget* m_statsStack;
+    QVector<Stats*> m_stats;
 
     void cancelProcess(QProcess* process, QLabel* status);
     void cancelAllProcesses();
@@ -110,116 +130,51 @@ private:
     // ----- Algo run -----
 
     QPushButton* m_runButton;
-    QProcess* m_runProcess;
     QLabel* m_runStatus;
+    QVector<MouseSession*> m_sessions;
 
     void startRun();
     void cancelRun();
-    void onRunExit(int exitCode, QProcess::ExitStatus exitStatus);
+    void onRunExit();
+    bool isRunning() const;
+
+    void removeMiceFromMaze();
+
+    // ----- View -----
 
-    Mouse* m_mouse;
-    MazeView* m_view;
-    MouseGraphic* m_mouseGraphic;
+    // Either the truth or one of the mice's views of the maze
+    QComboBox* m_viewComboBox;
 
-    void removeMouseFromMaze();
+    void onViewComboBoxChanged(int index);
+    void refreshViewComboBox(QStringList names);
+
+    // The field drawn as text on the truth, one of FIELDS()
+    QComboBox* m_overlayComboBox;
+
+    void onOverlayComboBoxChanged(int index);
+    void updateTruthOverlay();
 
     // ----- Pause/reset ----
 
     bool m_isPaused;
-    bool m_wasReset;
     QPushButton* m_pauseButton;
     QPushButton* m_resetButton;
 
     void onPauseButtonPressed();
     void onResetButtonPressed();
-
-    // ----- Communication -----
-
-    static const QString ACK;
-    static const QString CRASH;
-    static const QString INVALID;
-
-    // Buffers to hold incomplete output, only
-    // process once terminated with a newline
-    QStringList m_logBuffer;
-    QStringList m_commandBuffer;
-    QStringList processText(QString text, QStringList* buffer);
-
-    QQueue<QString> m_commandQueue;
-    QTimer* m_commandQueueTimer;
-
-    void dispatchCommand(QString command);
-    QString executeCommand(QString command);
-    void processQueuedCommands();
+    void onResetAcknowledged();
 
     // ----- Movement -----
 
     static const int SPEED_SLIDER_MAX;
     static const int SPEED_SLIDER_DEFAULT;
-    static const double PROGRESS_REQUIRED_FOR_MOVE;
-    static const double PROGRESS_REQUIRED_FOR_TURN;
-    static const double MIN_PROGRESS_PER_SECOND;
-    static const double MAX_PROGRESS_PER_SECOND;
-    static const double MAX_SLEEP_SECONDS;
-
-    // TODO: upforgrabs
-    // Encapsulate this state in the mouse class
-
-    QPair<int, int> m_startingLocation;
-    Direction m_startingDirection;
-    Movement m_movement;
-    bool m_doomedToCrash; // if the requested movement will result in a crash
-    int m_movesRemaining; // the number of allowable forward steps remaining
-    double m_movementProgress;
-    double m_movementStepSize;
-    QSlider* m_speedSlider;
 
-    double progressRequired(Movement movement);
-    void updateMouseProgress(double progress);
-    void scheduleMouseProgressUpdate();
-    bool isMoving();
+    QSlider* m_speedSlider;
 
     // ----- Scoreboard -----
-    Stats* stats;
-    void createStat(QString name, enum StatsEnum stat, int labelRow, int labelCol, int valueRow, int valueCol, QGridLayout* layout);
-
-    // ----- API -----
-
-    int mazeWidth();
-    int mazeHeight();
-
-    bool wallFront(int distance);
-    bool wallRight();
-    bool wallLeft();
-
-    bool moveForward(int distance);
-    void turnRight();
-    void turnLeft();
-
-    void setWall(int x, int y, QChar direction);
-    void clearWall(int x, int y, QChar direction);
-
-    void setColor(int x, int y, QChar color);
-    void clearColor(int x, int y);
-    void clearAllColor();
-
-    void setText(int x, int y, QString text);
-    void clearText(int x, int y);
-    void clearAllText();
-
-    bool wasReset();
-    void ackReset();
-
-    // ----- Helpers -----
-
-    QSet<QPair<int, int>> m_tilesWithColor;
-    QSet<QPair<int, int>> m_tilesWithText;
 
-    QString boolToString(bool value) const;
-    bool isWall(Wall wall) const;
-    bool isWithinMaze(int x, int y) const;
-    Wall getOpposingWall(Wall wall) const;
-    Coordinate getCenterOfTile(int x, int y) const;
+    QWidget* createStatsWidget(Stats* stats);
+    void createStat(Stats* stats, QString name, enum StatsEnum stat, int labelRow, int labelCol, int valueRow, int valueCol, QGridLayout* layout);
 };
 
 } 
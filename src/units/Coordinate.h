@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cmath>
+
+#include "../AssertMacros.h"
 #include "Angle.h"
 #include "Distance.h"
 
@@ -9,30 +12,97 @@ class Coordinate {
 
 public:
 
-    Coordinate();
-    static Coordinate Cartesian(const Distance& x, const Distance& y);
+    constexpr Coordinate();
+    static constexpr Coordinate Cartesian(const Distance& x, const Distance& y);
     static Coordinate Polar(const Distance& rho, const Angle& theta);
 
-    Distance getX() const;
-    Distance getY() const;
+    constexpr Distance getX() const;
+    constexpr Distance getY() const;
     Distance getRho() const;
     Angle getTheta() const;
 
-    Coordinate operator*(double factor) const;
+    constexpr Coordinate operator*(double factor) const;
     Coordinate operator/(double factor) const;
-    Coordinate operator+(const Coordinate& other) const;
-    Coordinate operator-(const Coordinate& other) const;
-    bool operator==(const Coordinate& other) const;
-    bool operator!=(const Coordinate& other) const;
-    bool operator<(const Coordinate& other) const;
+    constexpr Coordinate operator+(const Coordinate& other) const;
+    constexpr Coordinate operator-(const Coordinate& other) const;
+    constexpr bool operator==(const Coordinate& other) const;
+    constexpr bool operator!=(const Coordinate& other) const;
+    constexpr bool operator<(const Coordinate& other) const;
     void operator+=(const Coordinate& other);
 
 private:
 
     Distance m_x;
     Distance m_y;
-    Coordinate(const Distance& x, const Distance& y);
+    constexpr Coordinate(const Distance& x, const Distance& y);
 
 };
 
-} 
+constexpr Coordinate::Coordinate() : m_x(), m_y() {
+}
+
+constexpr Coordinate Coordinate::Cartesian(
+        const Distance& x, const Distance& y) {
+    return Coordinate(x, y);
+}
+
+inline Coordinate Coordinate::Polar(const Distance& rho, const Angle& theta) {
+    return Coordinate(rho * theta.getCos(), rho * theta.getSin());
+}
+
+constexpr Distance Coordinate::getX() const {
+    return m_x;
+}
+
+constexpr Distance Coordinate::getY() const {
+    return m_y;
+}
+
+inline Distance Coordinate::getRho() const {
+    return Distance::Meters(std::hypot(m_x.getMeters(), m_y.getMeters()));
+}
+
+inline Angle Coordinate::getTheta() const {
+    return Angle::Radians(std::atan2(m_y.getMeters(), m_x.getMeters()));
+}
+
+constexpr Coordinate Coordinate::operator*(double factor) const {
+    return Coordinate(m_x * factor, m_y * factor);
+}
+
+inline Coordinate Coordinate::operator/(double factor) const {
+    ASSERT_NE(factor, 0.0);
+    return Coordinate(m_x / factor, m_y / factor);
+}
+
+constexpr Coordinate Coordinate::operator+(const Coordinate& other) const {
+    return Coordinate(m_x + other.m_x, m_y + other.m_y);
+}
+
+constexpr Coordinate Coordinate::operator-(const Coordinate& other) const {
+    return Coordinate(m_x - other.m_x, m_y - other.m_y);
+}
+
+constexpr bool Coordinate::operator==(const Coordinate& other) const {
+    return (m_x == other.m_x) && (m_y == other.m_y);
+}
+
+constexpr bool Coordinate::operator!=(const Coordinate& other) const {
+    return !((m_x == other.m_x) && (m_y == other.m_y));
+}
+
+constexpr bool Coordinate::operator<(const Coordinate& other) const {
+    return (m_x != other.m_x ? m_x < other.m_x : m_y < other.m_y);
+}
+
+inline void Coordinate::operator+=(const Coordinate& other) {
+    m_x += other.m_x;
+    m_y += other.m_y;
+}
+
+constexpr Coordinate::Coordinate(const Distance& x, const Distance& y) :
+    m_x(x),
+    m_y(y) {
+}
+
+}
@@ -1,31 +1,87 @@
 #pragma once
 
+#include "../AssertMacros.h"
+
 namespace mms {
 
+// Like the other units, Distance is defined entirely in its header, so that
+// arithmetic on distances is inlined into plain arithmetic on doubles
 class Distance {
 
 public:
 
-    Distance();
-    static Distance Meters(double meters);
+    constexpr Distance();
+    static constexpr Distance Meters(double meters);
 
-    double getMeters() const;
+    constexpr double getMeters() const;
 
-    Distance operator*(double factor) const;
+    constexpr Distance operator*(double factor) const;
     Distance operator/(double factor) const;
-    Distance operator+(const Distance& other) const;
-    Distance operator-(const Distance& other) const;
+    constexpr Distance operator+(const Distance& other) const;
+    constexpr Distance operator-(const Distance& other) const;
     double operator/(const Distance& other) const;
-    bool operator==(const Distance& other) const;
-    bool operator!=(const Distance& other) const;
-    bool operator<(const Distance& other) const;
+    constexpr bool operator==(const Distance& other) const;
+    constexpr bool operator!=(const Distance& other) const;
+    constexpr bool operator<(const Distance& other) const;
     void operator+=(const Distance& other);
 
 private:
 
     double m_meters;
-    Distance(double meters);
+    constexpr Distance(double meters);
 
 };
 
-} 
+constexpr Distance::Distance() : m_meters(0.0) {
+}
+
+constexpr Distance Distance::Meters(double meters) {
+    return Distance(meters);
+}
+
+constexpr double Distance::getMeters() const {
+    return m_meters;
+}
+
+constexpr Distance Distance::operator*(double factor) const {
+    return Distance(m_meters * factor);
+}
+
+inline Distance Distance::operator/(double factor) const {
+    ASSERT_NE(factor, 0.0);
+    return Distance(m_meters / factor);
+}
+
+constexpr Distance Distance::operator+(const Distance& other) const {
+    return Distance(m_meters + other.m_meters);
+}
+
+constexpr Distance Distance::operator-(const Distance& other) const {
+    return Distance(m_meters - other.m_meters);
+}
+
+inline double Distance::operator/(const Distance& other) const {
+    ASSERT_NE(other.m_meters, 0.0);
+    return m_meters / other.m_meters;
+}
+
+constexpr bool Distance::operator==(const Distance& other) const {
+    return m_meters == other.m_meters;
+}
+
+constexpr bool Distance::operator!=(const Distance& other) const {
+    return !(m_meters == other.m_meters);
+}
+
+constexpr bool Distance::operator<(const Distance& other) const {
+    return m_meters < other.m_meters;
+}
+
+inline void Distance::operator+=(const Distance& other) {
+    m_meters += other.m_meters;
+}
+
+constexpr Distance::Distance(double meters) : m_meters(meters) {
+}
+
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Angle.h"
+#include "Coordinate.h"
+#include "Distance.h"
+
+namespace mms {
+
+// A rotation about the origin, as a 2x2 matrix. The sine and cosine are only
+// computed once, so that rotating each vertex of a polygon is just a few
+// multiplications, rather than a round trip through polar coordinates.
+class Rotation {
+
+public:
+
+    explicit Rotation(const Angle& angle);
+
+    Coordinate rotate(const Coordinate& coordinate) const;
+
+private:
+
+    double m_cos;
+    double m_sin;
+
+};
+
+inline Rotation::Rotation(const Angle& angle) :
+    m_cos(angle.getCos()),
+    m_sin(angle.getSin()) {
+}
+
+inline Coordinate Rotation::rotate(const Coordinate& coordinate) const {
+    return Coordinate::Cartesian(
+        coordinate.getX() * m_cos - coordinate.getY() * m_sin,
+        coordinate.getX() * m_sin + coordinate.getY() * m_cos);
+}
+
+}
@@ -0,0 +1,197 @@
+#include "FloodFillTest.h"
+
+#include <QtTest>
+
+#include <random>
+
+#include "Direction.h"
+#include "FloodFill.h"
+
+namespace mms {
+
+WallGrid FloodFillTest::generate(
+        int width, int height, double loops, bool open, unsigned seed) {
+
+    std::mt19937 rng(seed);
+    WallGrid walls(width, height);
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            for (Direction direction : DIRECTIONS()) {
+                walls.setWall(x, y, direction, !open);
+            }
+        }
+    }
+
+    // Carve a perfect maze with a depth first search; both sides of a wall
+    // are the same bit, so each wall only has to be cleared once
+    if (!open) {
+        QVector<bool> visited(width * height, false);
+        QVector<QPair<int, int>> stack = {{0, 0}};
+        visited[0] = true;
+        while (!stack.isEmpty()) {
+            int x = stack.last().first;
+            int y = stack.last().second;
+            QVector<Direction> options;
+            if (y + 1 < height && !visited.at(x * height + y + 1)) {
+                options.append(Direction::NORTH);
+            }
+            if (x + 1 < width && !visited.at((x + 1) * height + y)) {
+                options.append(Direction::EAST);
+            }
+            if (0 < y && !visited.at(x * height + y - 1)) {
+                options.append(Direction::SOUTH);
+            }
+            if (0 < x && !visited.at((x - 1) * height + y)) {
+                options.append(Direction::WEST);
+            }
+            if (options.isEmpty()) {
+                stack.removeLast();
+                continue;
+            }
+            Direction direction = options.at(rng() % options.size());
+            walls.setWall(x, y, direction, false);
+            int nx = x;
+            int ny = y;
+            if (direction == Direction::NORTH) {
+                ny += 1;
+            }
+            if (direction == Direction::EAST) {
+                nx += 1;
+            }
+            if (direction == Direction::SOUTH) {
+                ny -= 1;
+            }
+            if (direction == Direction::WEST) {
+                nx -= 1;
+            }
+            visited[nx * height + ny] = true;
+            stack.append({nx, ny});
+        }
+    }
+
+    // Knock out extra walls to make loops
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            if (x + 1 < width && uniform(rng) < loops) {
+                walls.setWall(x, y, Direction::EAST, false);
+            }
+            if (y + 1 < height && uniform(rng) < loops) {
+                walls.setWall(x, y, Direction::NORTH, false);
+            }
+        }
+    }
+
+    // Enclose the maze
+    for (int x = 0; x < width; x += 1) {
+        walls.setWall(x, 0, Direction::SOUTH, true);
+        walls.setWall(x, height - 1, Direction::NORTH, true);
+    }
+    for (int y = 0; y < height; y += 1) {
+        walls.setWall(0, y, Direction::WEST, true);
+        walls.setWall(width - 1, y, Direction::EAST, true);
+    }
+    return walls;
+}
+
+QVector<QPair<int, int>> FloodFillTest::getCenterAndCorner(
+        int width, int height) {
+    return {{(width - 1) / 2, (height - 1) / 2}, {width - 1, height - 1}};
+}
+
+void FloodFillTest::testMethodsAgree_data() {
+
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<double>("loops");
+    QTest::addColumn<bool>("open");
+
+    // Widths of 63 to 65 and 255 to 257 cross word and block boundaries
+    QVector<QPair<int, int>> sizes = {
+        {1, 1}, {1, 7}, {7, 1}, {16, 16}, {63, 5}, {64, 64}, {65, 3},
+        {255, 9}, {256, 4}, {257, 11}, {300, 17}, {513, 40}, {1000, 3},
+    };
+    for (QPair<int, int> size : sizes) {
+        int width = size.first;
+        int height = size.second;
+        QString name = QString("%1x%2 ").arg(width).arg(height);
+        QTest::newRow(qPrintable(name + "perfect"))
+            << width << height << 0.0 << false;
+        QTest::newRow(qPrintable(name + "loops"))
+            << width << height << 0.1 << false;
+        QTest::newRow(qPrintable(name + "open"))
+            << width << height << 0.0 << true;
+    }
+}
+
+void FloodFillTest::testMethodsAgree() {
+
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(double, loops);
+    QFETCH(bool, open);
+
+    WallGrid walls = generate(width, height, loops, open, width * height);
+    QVector<QPair<int, int>> sources = getCenterAndCorner(width, height);
+
+    FloodFill queue(walls, FloodFillMethod::QUEUE);
+    QVector<int> expected = queue.getDistances(sources);
+    QCOMPARE(expected.size(), width * height);
+    QVERIFY(!expected.contains(-1));
+
+    FloodFill scalar(walls, FloodFillMethod::BIT_PARALLEL);
+    QCOMPARE(scalar.getDistances(sources), expected);
+
+    if (FloodFill::isAvx2Supported()) {
+        FloodFill avx2(walls, FloodFillMethod::BIT_PARALLEL_AVX2);
+        QCOMPARE(avx2.getDistances(sources), expected);
+    }
+
+    // Cells walled off from the sources are unreachable by every method
+    walls.setWall(0, 0, Direction::NORTH, true);
+    walls.setWall(0, 0, Direction::EAST, true);
+    QVector<QPair<int, int>> center = {sources.first()};
+    expected = FloodFill(walls, FloodFillMethod::QUEUE).getDistances(center);
+    if (center.first() != qMakePair(0, 0)) {
+        QCOMPARE(expected.first(), -1);
+    }
+    QCOMPARE(
+        FloodFill(walls, FloodFillMethod::BIT_PARALLEL).getDistances(center),
+        expected);
+    if (FloodFill::isAvx2Supported()) {
+        QCOMPARE(
+            FloodFill(walls, FloodFillMethod::BIT_PARALLEL_AVX2)
+                .getDistances(center),
+            expected);
+    }
+}
+
+void FloodFillTest::testBestMethod() {
+
+    // Perfect and small mazes are searched with the queue
+    QCOMPARE(
+        FloodFill::getBestMethod(generate(16, 16, 0.0, false, 1)),
+        FloodFillMethod::QUEUE);
+    QCOMPARE(
+        FloodFill::getBestMethod(generate(16, 16, 0.0, true, 1)),
+        FloodFillMethod::QUEUE);
+    QCOMPARE(
+        FloodFill::getBestMethod(generate(128, 128, 0.0, false, 1)),
+        FloodFillMethod::QUEUE);
+    QCOMPARE(
+        FloodFill::getBestMethod(generate(512, 512, 0.0, true, 1)),
+        FloodFillMethod::QUEUE);
+
+    // Mid-sized open or loopy mazes are searched bit-parallel
+    FloodFillMethod bitParallel = FloodFill::isAvx2Supported()
+        ? FloodFillMethod::BIT_PARALLEL_AVX2
+        : FloodFillMethod::BIT_PARALLEL;
+    QCOMPARE(
+        FloodFill::getBestMethod(generate(128, 128, 0.2, false, 1)),
+        bitParallel);
+    QCOMPARE(
+        FloodFill::getBestMethod(generate(256, 256, 0.0, true, 1)),
+        bitParallel);
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QObject>
+#include <QPair>
+#include <QVector>
+
+#include "WallGrid.h"
+
+namespace mms {
+
+// Checks that every FloodFill method finds the same distances, on mazes whose
+// sizes straddle the word and block boundaries of the bit-parallel method
+class FloodFillTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void testMethodsAgree_data();
+    void testMethodsAgree();
+    void testBestMethod();
+
+private:
+
+    // A random perfect maze, with each interior wall then removed with the
+    // given probability; if open, every interior wall is removed instead
+    static WallGrid generate(
+        int width, int height, double loops, bool open, unsigned seed);
+
+    static QVector<QPair<int, int>> getCenterAndCorner(int width, int height);
+};
+
+}
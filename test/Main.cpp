@@ -0,0 +1,32 @@
+#include <QVector>
+#include <QtTest>
+
+#include "FloodFillTest.h"
+#include "MazeCorpusTest.h"
+#include "MazeFileTest.h"
+#include "MazeGeneratorTest.h"
+#include "MazeGraphicTest.h"
+#include "MazeHashTest.h"
+#include "OrientedMazeTest.h"
+
+// Runs every test class in turn, passing each the same arguments, and fails
+// if any of them do
+int main(int argc, char* argv[]) {
+    QVector<QObject*> tests = {
+        new mms::FloodFillTest(),
+        new mms::MazeCorpusTest(),
+        new mms::MazeFileTest(),
+        new mms::MazeGeneratorTest(),
+        new mms::MazeGraphicTest(),
+        new mms::MazeHashTest(),
+        new mms::OrientedMazeTest(),
+    };
+    int status = 0;
+    for (QObject* test : tests) {
+        if (QTest::qExec(test, argc, argv) != 0) {
+            status = 1;
+        }
+        delete test;
+    }
+    return status;
+}
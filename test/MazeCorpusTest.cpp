@@ -0,0 +1,214 @@
+#include "MazeCorpusTest.h"
+
+#include <QFile>
+#include <QtEndian>
+#include <QtTest>
+
+#include "FieldEngine.h"
+#include "Maze.h"
+#include "MazeCorpus.h"
+#include "MazeGenerator.h"
+#include "MazeHash.h"
+#include "TestUtilities.h"
+
+namespace mms {
+
+// Offsets within the file, see the README
+static const int HEADER_SIZE = 16;
+static const int ENTRY_SIZE = 56;
+
+void MazeCorpusTest::initTestCase() {
+
+    // Mazes of several sizes, including one whose center can't be reached,
+    // and names that aren't ASCII or that contain the reference separator
+    QVERIFY(m_directory.isValid());
+    m_mazes.insert(
+        "tomasz.num",
+        MazeGenerator(MazeAlgorithm::TOMASZ, 16, 16).generate(1));
+    m_mazes.insert(
+        "sub/randomize.map",
+        MazeGenerator(MazeAlgorithm::RANDOMIZE, 65, 3).generate(2));
+    m_mazes.insert(
+        QString::fromUtf8("caf\xc3\xa9.maz"),
+        MazeGenerator(MazeAlgorithm::TOMASZ, 7, 7).generate(3));
+    m_mazes.insert("#1", TestUtilities::getRandomWalls(1, 1, true, 4));
+    m_mazes.insert("walled", TestUtilities::getRandomWalls(9, 5, true, 5));
+    for (int x = 0; x < 9; x += 1) {
+        m_mazes["walled"].setWall(x, 1, Direction::NORTH, true);
+    }
+
+    QString path = m_directory.filePath("mazes.mzc");
+    QVERIFY(MazeCorpus::write(path, m_mazes));
+    QFile file(path);
+    QVERIFY(file.open(QFile::ReadOnly));
+    m_contents = file.readAll();
+}
+
+void MazeCorpusTest::testRoundTrip() {
+
+    MazeCorpus* corpus =
+        MazeCorpus::open(m_directory.filePath("mazes.mzc"));
+    QVERIFY(corpus != nullptr);
+    QCOMPARE(corpus->getCount(), m_mazes.size());
+
+    // Entries are in order of name, and the stats are those of the maze
+    int index = 0;
+    for (auto it = m_mazes.constBegin(); it != m_mazes.constEnd(); ++it) {
+        const WallGrid& walls = it.value();
+        Maze* maze = Maze::fromWalls(walls);
+        QVERIFY(maze != nullptr);
+
+        MazeCorpus::Entry entry = corpus->getEntry(index);
+        QCOMPARE(entry.name, it.key());
+        QCOMPARE(entry.width, walls.getWidth());
+        QCOMPARE(entry.height, walls.getHeight());
+        QCOMPARE(entry.hash, MazeHash::getHash(walls));
+        QCOMPARE(entry.optimalScore, FieldEngine(maze).getOptimalScore());
+        QCOMPARE(entry.shortestPath, maze->getDistance(0, 0));
+        int maxDistance = -1;
+        int unreachableCells = 0;
+        for (int x = 0; x < maze->getWidth(); x += 1) {
+            for (int y = 0; y < maze->getHeight(); y += 1) {
+                maxDistance = qMax(maxDistance, maze->getDistance(x, y));
+                if (maze->getDistance(x, y) == -1) {
+                    unreachableCells += 1;
+                }
+            }
+        }
+        QCOMPARE(entry.maxDistance, maxDistance);
+        QCOMPARE(entry.unreachableCells, unreachableCells);
+
+        WallGrid copy = corpus->getWalls(index);
+        QCOMPARE(copy.getWidth(), walls.getWidth());
+        QCOMPARE(copy.getHeight(), walls.getHeight());
+        QCOMPARE(copy.getHorizontalWalls(), walls.getHorizontalWalls());
+        QCOMPARE(copy.getVerticalWalls(), walls.getVerticalWalls());
+        QCOMPARE(corpus->find(it.key()), index);
+        delete maze;
+        index += 1;
+    }
+    QCOMPARE(corpus->find("missing"), -1);
+    QCOMPARE(corpus->find(""), -1);
+
+    // The walled off maze has cells that can't reach the center
+    MazeCorpus::Entry walled = corpus->getEntry(corpus->find("walled"));
+    QCOMPARE(walled.optimalScore, -1.0f);
+    QCOMPARE(walled.shortestPath, -1);
+    QVERIFY(0 < walled.unreachableCells);
+    delete corpus;
+}
+
+void MazeCorpusTest::testReference() {
+
+    // Only the first separator splits the file from the name
+    QString path = m_directory.filePath("mazes.mzc");
+    for (const QString& name : m_mazes.keys()) {
+        QString reference = MazeCorpus::getReference(path, name);
+        QCOMPARE(MazeCorpus::getFile(reference), path);
+        Maze* maze = MazeCorpus::fromReference(reference);
+        QVERIFY(maze != nullptr);
+        QCOMPARE(
+            maze->getWalls().getHorizontalWalls(),
+            m_mazes.value(name).getHorizontalWalls());
+        delete maze;
+    }
+    QVERIFY(MazeCorpus::fromReference(path + "#missing") == nullptr);
+    QVERIFY(MazeCorpus::fromReference(path) == nullptr);
+}
+
+void MazeCorpusTest::testWriteRejected() {
+
+    // Nothing is written unless every maze can be
+    QString path = m_directory.filePath("rejected.mzc");
+    QMap<QString, WallGrid> mazes = m_mazes;
+    mazes.insert("", m_mazes.first());
+    QVERIFY(!MazeCorpus::write(path, mazes));
+    QVERIFY(!QFile::exists(path));
+
+    mazes = m_mazes;
+    mazes.insert("open", TestUtilities::getRandomWalls(4, 4, true, 6));
+    mazes["open"].setWall(0, 0, Direction::SOUTH, false);
+    QVERIFY(!MazeCorpus::write(path, mazes));
+    QVERIFY(!QFile::exists(path));
+
+    path = m_directory.filePath("missing/rejected.mzc");
+    QVERIFY(!MazeCorpus::write(path, m_mazes));
+}
+
+void MazeCorpusTest::testTruncated() {
+
+    // The walls of the last maze run to the end of the file, so every
+    // truncation cuts something off
+    QVERIFY(canOpen(m_contents));
+    for (int size = 0; size < m_contents.size(); size += 1) {
+        QVERIFY2(!canOpen(m_contents.left(size)), qPrintable(
+            QString("truncated to %1 bytes").arg(size)));
+    }
+}
+
+void MazeCorpusTest::testMalformed_data() {
+
+    QTest::addColumn<int>("offset");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<quint64>("value");
+
+    // Offsets within the first entry, see the README
+    int entry = HEADER_SIZE;
+    QTest::newRow("magic") << 0 << 1 << quint64('N');
+    QTest::newRow("version") << 8 << 4 << quint64(2);
+    int count = (m_contents.size() - HEADER_SIZE) / ENTRY_SIZE;
+    QTest::newRow("count too large") << 12 << 4 << quint64(count + 1);
+    QTest::newRow("count overflow") << 12 << 4 << quint64(0xffffffff);
+    QTest::newRow("walls misaligned")
+        << entry << 8 << quint64(m_contents.size() - 8 * 8 + 4);
+    QTest::newRow("walls past the end")
+        << entry << 8 << quint64(m_contents.size());
+    QTest::newRow("walls overflow")
+        << entry << 8 << quint64(0xfffffffffffffff8);
+    QTest::newRow("name past the end")
+        << entry + 8 << 8 << quint64(m_contents.size() + 1);
+    QTest::newRow("name overflow")
+        << entry + 8 << 8 << quint64(0xffffffffffffffff);
+    QTest::newRow("name too long")
+        << entry + 24 << 4 << quint64(m_contents.size());
+    QTest::newRow("zero width") << entry + 28 << 4 << quint64(0);
+    QTest::newRow("zero height") << entry + 32 << 4 << quint64(0);
+    QTest::newRow("walls too large")
+        << entry + 28 << 4 << quint64(0x10000000);
+    QTest::newRow("bits overflow")
+        << entry + 28 << 4 << quint64(0xffffffff);
+    QTest::newRow("last entry's walls past the end")
+        << entry + (m_mazes.size() - 1) * ENTRY_SIZE << 8
+        << quint64(m_contents.size() - 8);
+}
+
+void MazeCorpusTest::testMalformed() {
+
+    QFETCH(int, offset);
+    QFETCH(int, size);
+    QFETCH(quint64, value);
+
+    QByteArray contents = m_contents;
+    uchar* data = reinterpret_cast<uchar*>(contents.data()) + offset;
+    if (size == 1) {
+        *data = value;
+    }
+    else if (size == 4) {
+        qToLittleEndian<quint32>(value, data);
+    }
+    else {
+        qToLittleEndian<quint64>(value, data);
+    }
+    QVERIFY(!canOpen(contents));
+}
+
+bool MazeCorpusTest::canOpen(const QByteArray& contents) {
+    QString path = TestUtilities::writeFile(
+        m_directory.path(), "malformed.mzc", contents);
+    MazeCorpus* corpus = MazeCorpus::open(path);
+    bool isOpen = corpus != nullptr;
+    delete corpus;
+    return isOpen;
+}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QByteArray>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+
+#include "WallGrid.h"
+
+namespace mms {
+
+// Checks that corpora hold exactly the mazes they were written from, and
+// that files that would read outside of themselves are never opened
+class MazeCorpusTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void testRoundTrip();
+    void testReference();
+    void testWriteRejected();
+    void testTruncated();
+    void testMalformed_data();
+    void testMalformed();
+
+private:
+
+    QTemporaryDir m_directory;
+    QMap<QString, WallGrid> m_mazes;
+    QByteArray m_contents; // of a corpus of m_mazes
+
+    // Whether the contents can be opened as a corpus
+    bool canOpen(const QByteArray& contents);
+};
+
+}
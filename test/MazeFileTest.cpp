@@ -0,0 +1,226 @@
+#include "MazeFileTest.h"
+
+#include <QFile>
+#include <QtTest>
+
+#include "Maze.h"
+#include "TestUtilities.h"
+
+namespace mms {
+
+void MazeFileTest::testRoundTrip_data() {
+
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    // Widths of 64 and 65 put the edges of the planes on word boundaries
+    QVector<QPair<int, int>> sizes = {
+        {1, 1}, {1, 5}, {5, 1}, {3, 7}, {16, 16}, {64, 3}, {65, 65},
+    };
+    for (QString format : {"num", "map", "maz"}) {
+        for (QPair<int, int> size : sizes) {
+            if (format == "maz" && size.first != size.second) {
+                continue;
+            }
+            QString name = QString("%1 %2x%3")
+                .arg(format).arg(size.first).arg(size.second);
+            QTest::newRow(qPrintable(name))
+                << format << size.first << size.second;
+        }
+    }
+}
+
+void MazeFileTest::testRoundTrip() {
+
+    QFETCH(QString, format);
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    QVERIFY(m_directory.isValid());
+    WallGrid walls = TestUtilities::getRandomWalls(
+        width, height, true, width * height);
+    QByteArray contents =
+        format == "num" ? TestUtilities::toNumFile(walls) :
+        format == "map" ? TestUtilities::toMapFile(walls) :
+        TestUtilities::toMazFile(walls);
+    QString path = TestUtilities::writeFile(
+        m_directory.path(), "maze." + format, contents);
+    QVERIFY(!path.isEmpty());
+
+    Maze* maze = Maze::fromFile(path);
+    QVERIFY(maze != nullptr);
+    QCOMPARE(maze->getWidth(), width);
+    QCOMPARE(maze->getHeight(), height);
+    QCOMPARE(maze->getWalls().getHorizontalWalls(), walls.getHorizontalWalls());
+    QCOMPARE(maze->getWalls().getVerticalWalls(), walls.getVerticalWalls());
+    delete maze;
+}
+
+void MazeFileTest::testNumFile() {
+
+    // Cells may be listed in any order, with any whitespace, CRLF line
+    // endings, and blank lines
+    QByteArray contents =
+        "\r\n"
+        "1 0 0 1 1 1\r\n"
+        "0 1 1 0 0 1\r\n"
+        "\r\n"
+        "  0\t0 0 1 1 1\r\n"
+        "1 1 1 1 0 0";
+    QString path = TestUtilities::writeFile(
+        m_directory.path(), "maze.num", contents);
+    Maze* maze = Maze::fromFile(path);
+    QVERIFY(maze != nullptr);
+    QCOMPARE(maze->getWidth(), 2);
+    QCOMPARE(maze->getHeight(), 2);
+    QVERIFY(maze->isWall(0, 0, Direction::EAST));
+    QVERIFY(!maze->isWall(0, 0, Direction::NORTH));
+    QVERIFY(!maze->isWall(1, 0, Direction::NORTH));
+    QVERIFY(!maze->isWall(0, 1, Direction::EAST));
+    delete maze;
+
+    // See testRejected(), which leaves out the center cell
+    contents =
+        "0 0 0 0 1 1\n0 1 0 0 0 1\n0 2 1 0 0 1\n"
+        "1 0 0 0 1 0\n1 1 0 0 0 0\n1 2 1 0 0 0\n"
+        "2 0 0 1 1 0\n2 1 0 1 0 0\n2 2 1 1 0 0\n";
+    path = TestUtilities::writeFile(m_directory.path(), "open.num", contents);
+    maze = Maze::fromFile(path);
+    QVERIFY(maze != nullptr);
+    QCOMPARE(maze->getDistance(0, 0), 2);
+    delete maze;
+}
+
+void MazeFileTest::testMapFile() {
+
+    // Any character other than a space is a wall, and blank lines around the
+    // maze are ignored
+    QByteArray contents =
+        "\r\n"
+        "+---+---+\r\n"
+        "|       #\r\n"
+        "+   +===+\r\n"
+        "|   |   |\r\n"
+        "+---+---+\r\n"
+        "\r\n";
+    QString path = TestUtilities::writeFile(
+        m_directory.path(), "maze.map", contents);
+    Maze* maze = Maze::fromFile(path);
+    QVERIFY(maze != nullptr);
+    QCOMPARE(maze->getWidth(), 2);
+    QCOMPARE(maze->getHeight(), 2);
+    QVERIFY(maze->isWall(0, 0, Direction::EAST));
+    QVERIFY(maze->isWall(1, 0, Direction::NORTH));
+    QVERIFY(!maze->isWall(0, 0, Direction::NORTH));
+    QVERIFY(!maze->isWall(0, 1, Direction::EAST));
+    delete maze;
+}
+
+void MazeFileTest::testShippedMazes_data() {
+    QTest::addColumn<QString>("name");
+    for (QString name : {
+        "apec2002.maz", "hitel01.maz", "hitel02.maz", "ieee2011.maz",
+        "jrhmaze.maz", "longpath.maz", "maze2011.maz", "mazeish.maz",
+        "minos03final.maz", "mm03fins.maz", "seoul01.maz", "seoul02.maz",
+        "blank.num", "example1.num", "example2.num", "example3.num",
+        "example4.num", "example5.num",
+    }) {
+        QTest::newRow(qPrintable(name)) << name;
+    }
+}
+
+void MazeFileTest::testShippedMazes() {
+
+    QFETCH(QString, name);
+
+    QString path = QFINDTESTDATA("../src/resources/mazes/" + name);
+    QVERIFY(!path.isEmpty());
+    Maze* maze = Maze::fromFile(path);
+    QVERIFY(maze != nullptr);
+    QCOMPARE(maze->getWidth(), 16);
+    QCOMPARE(maze->getHeight(), 16);
+    QVERIFY(Maze::isValid(maze->getWalls()));
+
+    // The bytes of a maz file are the wall masks, in the same order as the
+    // cells of a maze
+    if (name.endsWith(".maz")) {
+        QFile file(path);
+        QVERIFY(file.open(QFile::ReadOnly));
+        QCOMPARE(file.readAll(), TestUtilities::toMazFile(maze->getWalls()));
+    }
+    delete maze;
+}
+
+void MazeFileTest::testRejected_data() {
+
+    QTest::addColumn<QByteArray>("contents");
+
+    QTest::newRow("empty") << QByteArray("");
+    QTest::newRow("blank") << QByteArray(" \n\t\r\n");
+    QTest::newRow("text") << QByteArray("maze\n");
+
+    // The num file of the 2x1 maze "0 0 1 0 1 1" and "1 0 1 1 1 0"
+    QTest::newRow("num incomplete line")
+        << QByteArray("0 0 1 0 1 1\n1 0 1 1 1\n");
+    QTest::newRow("num extra value")
+        << QByteArray("0 0 1 0 1 1\n1 0 1 1 1 0 0\n");
+    QTest::newRow("num not a number")
+        << QByteArray("0 0 1 0 1 1\n1 0 1 1 1 x\n");
+    QTest::newRow("num negative")
+        << QByteArray("0 0 1 0 1 1\n-1 0 1 1 1 0\n");
+    QTest::newRow("num overflow")
+        << QByteArray("0 0 1 0 1 1\n99999999999 0 1 1 1 0\n");
+    QTest::newRow("num repeated cell")
+        << QByteArray("0 0 1 0 1 1\n1 0 1 1 1 0\n1 0 1 1 1 0\n");
+    QTest::newRow("num stray coordinate")
+        << QByteArray("0 0 1 0 1 1\n1 0 1 1 1 0\n60000 60000 1 1 1 1\n");
+    QTest::newRow("num inconsistent")
+        << QByteArray("0 0 1 1 1 1\n1 0 1 1 1 0\n");
+    QTest::newRow("num open edge")
+        << QByteArray("0 0 0 0 1 1\n1 0 1 1 1 0\n");
+
+    // A 3x3 maze without interior walls, missing its center cell. Listing
+    // another cell twice in its place gets the count right, and the missing
+    // cell, which has no walls, would go unnoticed if it weren't for the
+    // repeated one.
+    QByteArray open =
+        "0 0 0 0 1 1\n0 1 0 0 0 1\n0 2 1 0 0 1\n"
+        "1 0 0 0 1 0\n1 2 1 0 0 0\n"
+        "2 0 0 1 1 0\n2 1 0 1 0 0\n2 2 1 1 0 0\n";
+    QTest::newRow("num missing cell") << open;
+    QTest::newRow("num missing and repeated cells")
+        << open + "0 0 0 0 1 1\n";
+
+    // The map file of the 2x1 maze above
+    QTest::newRow("map even lines")
+        << QByteArray("+---+---+\n|       |\n");
+    QTest::newRow("map ragged")
+        << QByteArray("+---+---+\n|       |\n+---+\n");
+    QTest::newRow("map short wall line")
+        << QByteArray("+---+---+\n|      \n+---+---+\n");
+    QTest::newRow("map open edge")
+        << QByteArray("+---+---+\n|        \n+---+---+\n");
+    QTest::newRow("map open top")
+        << QByteArray("+   +---+\n|       |\n+---+---+\n");
+
+    // The maz file of a 2x2 maze without interior walls is 12, 9, 6, 3
+    QTest::newRow("maz not square")
+        << QByteArray("\x0c\x09\x06\x03\x0f", 5);
+    QTest::newRow("maz value too large")
+        << QByteArray("\x0c\x09\x06\x13", 4);
+    QTest::newRow("maz inconsistent")
+        << QByteArray("\x0e\x09\x06\x03", 4);
+    QTest::newRow("maz open edge")
+        << QByteArray("\x04\x09\x06\x03", 4);
+}
+
+void MazeFileTest::testRejected() {
+    QFETCH(QByteArray, contents);
+    QString path = TestUtilities::writeFile(
+        m_directory.path(), "rejected", contents);
+    QVERIFY(!path.isEmpty());
+    QVERIFY(Maze::fromFile(path) == nullptr);
+}
+
+}
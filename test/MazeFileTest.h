@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+namespace mms {
+
+// Checks that maze files are parsed back into the walls they were written
+// from, and that malformed or inconsistent files are rejected
+class MazeFileTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void testRoundTrip_data();
+    void testRoundTrip();
+    void testNumFile();
+    void testMapFile();
+    void testShippedMazes_data();
+    void testShippedMazes();
+    void testRejected_data();
+    void testRejected();
+
+private:
+
+    QTemporaryDir m_directory;
+};
+
+}
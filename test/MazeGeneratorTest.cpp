@@ -0,0 +1,162 @@
+#include "MazeGeneratorTest.h"
+
+#include <QSet>
+#include <QThread>
+#include <QtTest>
+
+#include "Maze.h"
+#include "MazeGenerator.h"
+#include "MazeHash.h"
+
+Q_DECLARE_METATYPE(mms::MazeAlgorithm)
+
+namespace mms {
+
+void MazeGeneratorTest::testDeterministic_data() {
+
+    QTest::addColumn<MazeAlgorithm>("algorithm");
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+
+    // Tomasz needs room for the center and a path around it
+    QVector<QPair<int, int>> sizes = {
+        {3, 3}, {4, 4}, {16, 16}, {33, 17}, {5, 64}, {65, 65},
+    };
+    for (MazeAlgorithm algorithm : MAZE_ALGORITHMS()) {
+        for (QPair<int, int> size : sizes) {
+            QString name = QString("%1 %2x%3")
+                .arg(MAZE_ALGORITHM_TO_STRING().value(algorithm))
+                .arg(size.first)
+                .arg(size.second);
+            QTest::newRow(qPrintable(name))
+                << algorithm << size.first << size.second;
+        }
+    }
+    QTest::newRow("Randomize 1x1") << MazeAlgorithm::RANDOMIZE << 1 << 1;
+    QTest::newRow("Randomize 2x1") << MazeAlgorithm::RANDOMIZE << 2 << 1;
+}
+
+void MazeGeneratorTest::testDeterministic() {
+
+    QFETCH(MazeAlgorithm, algorithm);
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    // A generator writes each maze over the previous one, which mustn't
+    // change the mazes that it already returned, or any later ones
+    MazeGenerator generator(algorithm, width, height);
+    QVector<WallGrid> mazes;
+    for (quint64 seed = 0; seed < 20; seed += 1) {
+        mazes.append(generator.generate(seed));
+    }
+    for (quint64 seed = 0; seed < 20; seed += 1) {
+        const WallGrid& maze = mazes.at(seed);
+        QCOMPARE(maze.getWidth(), width);
+        QCOMPARE(maze.getHeight(), height);
+        QVERIFY(Maze::isValid(maze));
+        WallGrid again = MazeGenerator(algorithm, width, height).generate(seed);
+        QCOMPARE(again.getHorizontalWalls(), maze.getHorizontalWalls());
+        QCOMPARE(again.getVerticalWalls(), maze.getVerticalWalls());
+    }
+
+    // Generating a maze out of order yields the same maze, too
+    WallGrid maze = generator.generate(7);
+    QCOMPARE(maze.getHorizontalWalls(), mazes.at(7).getHorizontalWalls());
+    QCOMPARE(maze.getVerticalWalls(), mazes.at(7).getVerticalWalls());
+
+    // Small mazes can repeat, e.g., there are few 4x4 Tomasz mazes, but
+    // bigger ones shouldn't
+    if (64 <= width * height) {
+        QSet<quint64> hashes;
+        for (const WallGrid& walls : mazes) {
+            hashes.insert(MazeHash::getHash(walls));
+        }
+        QCOMPARE(hashes.size(), mazes.size());
+    }
+}
+
+void MazeGeneratorTest::testGenerateMany_data() {
+
+    QTest::addColumn<MazeAlgorithm>("algorithm");
+    QTest::addColumn<int>("threads");
+
+    // More threads than mazes, too; the number of cores doesn't matter, since
+    // every thread is started regardless
+    for (MazeAlgorithm algorithm : MAZE_ALGORITHMS()) {
+        for (int threads : {1, 2, 3, 8, 64}) {
+            QString name = QString("%1 %2 threads")
+                .arg(MAZE_ALGORITHM_TO_STRING().value(algorithm))
+                .arg(threads);
+            QTest::newRow(qPrintable(name)) << algorithm << threads;
+        }
+    }
+}
+
+void MazeGeneratorTest::testGenerateMany() {
+
+    QFETCH(MazeAlgorithm, algorithm);
+    QFETCH(int, threads);
+
+    // Maze i is generate(seed + i), whichever thread generated it
+    int count = 37;
+    quint64 seed = 1000;
+    QVector<WallGrid> mazes =
+        MazeGenerator::generateMany(algorithm, 16, 12, seed, count, threads);
+    QCOMPARE(mazes.size(), count);
+    MazeGenerator generator(algorithm, 16, 12);
+    for (int i = 0; i < count; i += 1) {
+        WallGrid expected = generator.generate(seed + i);
+        QCOMPARE(mazes.at(i).getHorizontalWalls(), expected.getHorizontalWalls());
+        QCOMPARE(mazes.at(i).getVerticalWalls(), expected.getVerticalWalls());
+    }
+
+    QVERIFY(MazeGenerator::generateMany(algorithm, 16, 12, seed, 0, threads)
+        .isEmpty());
+}
+
+void MazeGeneratorTest::testSeeds() {
+
+    // The same seed yields the same maze across platforms and releases, so
+    // that a seed is enough to share a maze; if the algorithms are changed on
+    // purpose, these need updating
+    QCOMPARE(
+        MazeHash::getHash(
+            MazeGenerator(MazeAlgorithm::TOMASZ, 16, 16).generate(1)),
+        Q_UINT64_C(9087619248161036684));
+    QCOMPARE(
+        MazeHash::getHash(
+            MazeGenerator(MazeAlgorithm::RANDOMIZE, 16, 16).generate(1)),
+        Q_UINT64_C(8655461454748173936));
+}
+
+void MazeGeneratorTest::benchmarkGenerateMany_data() {
+
+    QTest::addColumn<MazeAlgorithm>("algorithm");
+    QTest::addColumn<int>("threads");
+
+    // One thread, and one per core, for comparing how generation scales
+    for (MazeAlgorithm algorithm : MAZE_ALGORITHMS()) {
+        for (int threads : {1, 0}) {
+            QString name = QString("%1 %2 threads")
+                .arg(MAZE_ALGORITHM_TO_STRING().value(algorithm))
+                .arg(threads == 0 ? QThread::idealThreadCount() : threads);
+            QTest::newRow(qPrintable(name)) << algorithm << threads;
+        }
+    }
+}
+
+void MazeGeneratorTest::benchmarkGenerateMany() {
+
+    QFETCH(MazeAlgorithm, algorithm);
+    QFETCH(int, threads);
+
+    int count = 1000;
+    QVector<WallGrid> mazes;
+    QBENCHMARK {
+        mazes = MazeGenerator::generateMany(
+            algorithm, 16, 16, 1, count, threads);
+    }
+    QCOMPARE(mazes.size(), count);
+}
+
+}
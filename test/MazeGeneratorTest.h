@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QObject>
+
+namespace mms {
+
+// Checks that every generated maze is valid, and that mazes depend only on
+// the algorithm, the dimensions, and the seed; also times generateMany() on
+// one thread and on every core
+class MazeGeneratorTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void testDeterministic_data();
+    void testDeterministic();
+    void testGenerateMany_data();
+    void testGenerateMany();
+    void testSeeds();
+    void benchmarkGenerateMany_data();
+    void benchmarkGenerateMany();
+};
+
+}
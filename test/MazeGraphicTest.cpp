@@ -0,0 +1,102 @@
+#include "MazeGraphicTest.h"
+
+#include <QSettings>
+#include <QtTest>
+
+#include <cstring>
+
+#include "Color.h"
+#include "ColorManager.h"
+#include "Maze.h"
+#include "MazeView.h"
+#include "Settings.h"
+#include "TestUtilities.h"
+
+namespace mms {
+
+// The vertices are plain floats and bytes without any padding, so buffers
+// that were drawn the same way are the same bytes
+template<class T>
+static bool isSameBuffer(const QVector<T>& buffer, const QVector<T>& other) {
+    return
+        buffer.size() == other.size() &&
+        std::memcmp(
+            buffer.constData(),
+            other.constData(),
+            buffer.size() * sizeof(T)) == 0;
+}
+
+void MazeGraphicTest::initTestCase() {
+    QVERIFY(m_directory.isValid());
+    QSettings::setDefaultFormat(QSettings::IniFormat);
+    QSettings::setPath(
+        QSettings::IniFormat, QSettings::UserScope, m_directory.path());
+    Settings::init();
+    ColorManager::init();
+}
+
+void MazeGraphicTest::testThreads_data() {
+
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<bool>("isTruthView");
+
+    // Mazes narrower than the number of threads get one column per thread
+    QTest::newRow("1x1 truth") << 1 << 1 << true;
+    QTest::newRow("5x7 belief") << 5 << 7 << false;
+    QTest::newRow("16x16 truth") << 16 << 16 << true;
+    QTest::newRow("33x20 belief") << 33 << 20 << false;
+    QTest::newRow("64x64 truth") << 64 << 64 << true;
+}
+
+void MazeGraphicTest::testThreads() {
+
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(bool, isTruthView);
+
+    WallGrid walls = TestUtilities::getRandomWalls(width, height, true, 1);
+    Maze* maze = Maze::fromWalls(walls);
+    QVERIFY(maze != nullptr);
+    MazeView view(maze, isTruthView);
+
+    // Give some of the tiles walls, colors, and text of their own
+    MazeGraphic* graphic = view.getMazeGraphic();
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            if ((x + y) % 3 == 0) {
+                graphic->setWall(x, y, Direction::NORTH);
+            }
+            if ((x * y) % 5 == 1) {
+                graphic->setColor(x, y, Color::GREEN);
+            }
+            if ((x + 2 * y) % 4 == 0) {
+                graphic->setText(x, y, QString::number(x * height + y));
+            }
+        }
+    }
+    graphic->flushUpdates();
+
+    graphic->setThreadCount(1);
+    graphic->drawPolygons();
+    graphic->drawTextures();
+    QVector<TriangleGraphic> graphicBuffer = *view.getGraphicCpuBuffer();
+    QVector<TriangleTexture> textureBuffer = *view.getTextureCpuBuffer();
+    QVERIFY(!graphicBuffer.isEmpty());
+    QVERIFY(!textureBuffer.isEmpty());
+
+    for (int threadCount : {2, 3, 8}) {
+        graphic->setThreadCount(threadCount);
+        graphic->drawPolygons();
+        graphic->drawTextures();
+        QVERIFY2(
+            isSameBuffer(*view.getGraphicCpuBuffer(), graphicBuffer),
+            qPrintable(QString("graphic, %1 threads").arg(threadCount)));
+        QVERIFY2(
+            isSameBuffer(*view.getTextureCpuBuffer(), textureBuffer),
+            qPrintable(QString("texture, %1 threads").arg(threadCount)));
+    }
+    delete maze;
+}
+
+}
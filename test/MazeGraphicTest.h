@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QObject>
+#include <QTemporaryDir>
+
+namespace mms {
+
+// Checks that drawing a maze on several threads fills the buffers exactly
+// as drawing it on one does
+class MazeGraphicTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void initTestCase();
+    void testThreads_data();
+    void testThreads();
+
+private:
+
+    // Holds the settings, so that the colors of the tiles are the defaults
+    // and the user's own settings are left alone
+    QTemporaryDir m_directory;
+};
+
+}
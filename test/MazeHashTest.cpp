@@ -0,0 +1,174 @@
+#include "MazeHashTest.h"
+
+#include <QtTest>
+
+#include "Direction.h"
+#include "MazeHash.h"
+#include "TestUtilities.h"
+
+Q_DECLARE_METATYPE(mms::Symmetry)
+
+namespace mms {
+
+WallGrid MazeHashTest::getSymmetricWalls(
+        int width, int height, Symmetry symmetry, quint64 seed) {
+
+    // Every symmetry is its own fourth power, so four images suffice
+    WallGrid walls = TestUtilities::getRandomWalls(width, height, true, seed);
+    WallGrid image = walls;
+    for (int i = 1; i < 4; i += 1) {
+        image = TestUtilities::getTransformedWalls(image, symmetry);
+        for (int x = 0; x < width; x += 1) {
+            for (int y = 0; y < height; y += 1) {
+                for (Direction direction : DIRECTIONS()) {
+                    if (image.isWall(x, y, direction)) {
+                        walls.setWall(x, y, direction, true);
+                    }
+                }
+            }
+        }
+    }
+    return walls;
+}
+
+QVector<Symmetry> MazeHashTest::getCanonicalSymmetries(
+        const WallGrid& walls) {
+    auto isLess = [](const WallGrid& a, const WallGrid& b) {
+        if (a.getWidth() != b.getWidth()) {
+            return a.getWidth() < b.getWidth();
+        }
+        if (a.getHeight() != b.getHeight()) {
+            return a.getHeight() < b.getHeight();
+        }
+        if (a.getHorizontalWalls() != b.getHorizontalWalls()) {
+            return a.getHorizontalWalls() < b.getHorizontalWalls();
+        }
+        return a.getVerticalWalls() < b.getVerticalWalls();
+    };
+    WallGrid least = walls;
+    for (Symmetry symmetry : SYMMETRIES()) {
+        WallGrid image = TestUtilities::getTransformedWalls(walls, symmetry);
+        if (isLess(image, least)) {
+            least = image;
+        }
+    }
+    QVector<Symmetry> symmetries;
+    for (Symmetry symmetry : SYMMETRIES()) {
+        WallGrid image = TestUtilities::getTransformedWalls(walls, symmetry);
+        if (!isLess(image, least) && !isLess(least, image)) {
+            symmetries.append(symmetry);
+        }
+    }
+    return symmetries;
+}
+
+void MazeHashTest::addRows() {
+
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<Symmetry>("symmetry");
+
+    // Widths and heights of 63 to 65 cross word boundaries, and the
+    // symmetries that swap the axes only leave square mazes unchanged
+    QVector<QPair<int, int>> sizes = {
+        {1, 1}, {1, 7}, {7, 1}, {2, 2}, {3, 5}, {16, 16}, {17, 17},
+        {63, 2}, {2, 64}, {65, 65}, {130, 3},
+    };
+    for (QPair<int, int> size : sizes) {
+        int width = size.first;
+        int height = size.second;
+        for (Symmetry symmetry : SYMMETRIES()) {
+            if (width != height && SYMMETRY_SWAPS_AXES().value(symmetry)) {
+                continue;
+            }
+            QString name = QString("%1x%2 %3")
+                .arg(width)
+                .arg(height)
+                .arg(SYMMETRY_TO_STRING().value(symmetry));
+            QTest::newRow(qPrintable(name)) << width << height << symmetry;
+        }
+    }
+}
+
+void MazeHashTest::testCanonicalHash_data() {
+    addRows();
+}
+
+void MazeHashTest::testCanonicalHash() {
+
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(Symmetry, symmetry);
+
+    // The canonical orientation is the least one, and the first of them if
+    // the maze is symmetric
+    quint64 seed = width * height;
+    WallGrid walls = getSymmetricWalls(width, height, symmetry, seed);
+    QVector<Symmetry> symmetries = getCanonicalSymmetries(walls);
+    Symmetry canonical = Symmetry::IDENTITY;
+    quint64 hash = MazeHash::getCanonicalHash(walls, &canonical);
+    QCOMPARE(canonical, symmetries.first());
+    QCOMPARE(
+        hash,
+        MazeHash::getHash(
+            TestUtilities::getTransformedWalls(walls, canonical)));
+    if (symmetry != Symmetry::IDENTITY) {
+        QVERIFY(1 < symmetries.size());
+    }
+
+    // Every image of the maze has the same canonical hash
+    for (Symmetry other : SYMMETRIES()) {
+        WallGrid image = TestUtilities::getTransformedWalls(walls, other);
+        QCOMPARE(MazeHash::getCanonicalHash(image), hash);
+    }
+}
+
+void MazeHashTest::testStartHash_data() {
+    addRows();
+}
+
+void MazeHashTest::testStartHash() {
+
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(Symmetry, symmetry);
+
+    // The least corner of the canonical orientation that the start is sent
+    // to; the mazes are enclosed, so for mazes one cell wide, the corners
+    // that are the same cell are also the same maze
+    auto getStartCorner = [](const WallGrid& walls) {
+        int corner = 3;
+        for (Symmetry canonical : getCanonicalSymmetries(walls)) {
+            WallGrid image =
+                TestUtilities::getTransformedWalls(walls, canonical);
+            bool swapAxes = SYMMETRY_SWAPS_AXES().value(canonical);
+            bool farX = SYMMETRY_MIRRORS_X().value(canonical);
+            bool farY = SYMMETRY_MIRRORS_Y().value(canonical);
+            if (swapAxes) {
+                qSwap(farX, farY);
+            }
+            farX = farX && 1 < image.getWidth();
+            farY = farY && 1 < image.getHeight();
+            corner = qMin(corner, (farX ? 1 : 0) + (farY ? 2 : 0));
+        }
+        return corner;
+    };
+
+    // Images of the maze share a start hash exactly when the start ends up
+    // in the same corner, which it always does for the identity and the
+    // transpose
+    quint64 seed = width * height;
+    WallGrid walls = getSymmetricWalls(width, height, symmetry, seed);
+    quint64 hash = MazeHash::getStartHash(walls);
+    int corner = getStartCorner(walls);
+    for (Symmetry other : SYMMETRIES()) {
+        WallGrid image = TestUtilities::getTransformedWalls(walls, other);
+        bool isSameCorner = getStartCorner(image) == corner;
+        QCOMPARE(MazeHash::getStartHash(image) == hash, isSameCorner);
+        if (other == Symmetry::IDENTITY || other == Symmetry::TRANSPOSE) {
+            QVERIFY(isSameCorner);
+        }
+    }
+}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QObject>
+#include <QVector>
+
+#include "Symmetry.h"
+#include "WallGrid.h"
+
+namespace mms {
+
+// Checks the canonical and start hashes against rotating and mirroring the
+// maze one wall at a time
+class MazeHashTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void testCanonicalHash_data();
+    void testCanonicalHash();
+    void testStartHash_data();
+    void testStartHash();
+
+private:
+
+    // Random walls that are left unchanged by the symmetry, i.e., the union
+    // of the walls with each of their images under its powers
+    static WallGrid getSymmetricWalls(
+        int width, int height, Symmetry symmetry, quint64 seed);
+
+    // Every symmetry that yields the least orientation of the walls, as
+    // ordered in MazeHash.h, in the order of SYMMETRIES()
+    static QVector<Symmetry> getCanonicalSymmetries(const WallGrid& walls);
+
+    // Rows of sizes and symmetries shared by both tests
+    static void addRows();
+};
+
+}
@@ -0,0 +1,99 @@
+#include "OrientedMazeTest.h"
+
+#include <QtTest>
+
+#include "Direction.h"
+#include "FieldEngine.h"
+#include "Maze.h"
+#include "MazeGenerator.h"
+#include "MazeHash.h"
+#include "OrientedMaze.h"
+#include "TestUtilities.h"
+
+Q_DECLARE_METATYPE(mms::WallGrid)
+
+namespace mms {
+
+void OrientedMazeTest::testOrientations_data() {
+
+    QTest::addColumn<WallGrid>("walls");
+
+    // Mazes that aren't square, whose centers are one, two, or four cells,
+    // and one whose start can't reach the center
+    QTest::newRow("Randomize 7x12")
+        << MazeGenerator(MazeAlgorithm::RANDOMIZE, 7, 12).generate(1);
+    QTest::newRow("Randomize 1x1")
+        << MazeGenerator(MazeAlgorithm::RANDOMIZE, 1, 1).generate(2);
+    QTest::newRow("Tomasz 9x5")
+        << MazeGenerator(MazeAlgorithm::TOMASZ, 9, 5).generate(3);
+    QTest::newRow("Tomasz 16x16")
+        << MazeGenerator(MazeAlgorithm::TOMASZ, 16, 16).generate(4);
+    QTest::newRow("Tomasz 65x33")
+        << MazeGenerator(MazeAlgorithm::TOMASZ, 65, 33).generate(5);
+    WallGrid walled = TestUtilities::getRandomWalls(8, 6, true, 6);
+    for (int x = 0; x < 8; x += 1) {
+        walled.setWall(x, 1, Direction::NORTH, true);
+    }
+    QTest::newRow("walled 8x6") << walled;
+}
+
+void OrientedMazeTest::testOrientations() {
+
+    QFETCH(WallGrid, walls);
+
+    Maze* maze = Maze::fromWalls(walls);
+    QVERIFY(maze != nullptr);
+    for (Symmetry symmetry : SYMMETRIES()) {
+        WallGrid expected =
+            TestUtilities::getTransformedWalls(walls, symmetry);
+        Maze* copy = Maze::fromWalls(expected);
+        QVERIFY(copy != nullptr);
+
+        // The view looks up the same walls and distances as the copy
+        OrientedMaze view(maze, symmetry);
+        QCOMPARE(view.getWidth(), copy->getWidth());
+        QCOMPARE(view.getHeight(), copy->getHeight());
+        for (int x = 0; x < view.getWidth(); x += 1) {
+            for (int y = 0; y < view.getHeight(); y += 1) {
+                for (Direction direction : DIRECTIONS()) {
+                    QCOMPARE(
+                        view.isWall(x, y, direction),
+                        copy->isWall(x, y, direction));
+                }
+                QCOMPARE(view.getDistance(x, y), copy->getDistance(x, y));
+            }
+        }
+
+        // So do the fields computed over it, and runs start in the same
+        // corner of the canonical orientation
+        FieldEngine oriented(maze, symmetry);
+        FieldEngine copied(copy);
+        for (Field field : FIELDS()) {
+            QCOMPARE(oriented.getField(field), copied.getField(field));
+        }
+        QCOMPARE(oriented.getOptimalScore(), copied.getOptimalScore());
+        QCOMPARE(
+            MazeHash::getStartHash(walls, symmetry),
+            MazeHash::getStartHash(expected));
+        delete copy;
+    }
+    delete maze;
+}
+
+void OrientedMazeTest::testClockwise() {
+
+    // Rotating a 2x3 maze clockwise by 90 degrees sends its northwest
+    // corner to the northeast, and its north to the east
+    WallGrid walls = TestUtilities::getRandomWalls(2, 3, true, 1);
+    Maze* maze = Maze::fromWalls(walls);
+    QVERIFY(maze != nullptr);
+    OrientedMaze view(maze, Symmetry::ROTATE_90);
+    QCOMPARE(view.getWidth(), 3);
+    QCOMPARE(view.getHeight(), 2);
+    QCOMPARE(view.toMaze(2, 1), qMakePair(0, 2));
+    QCOMPARE(view.toMaze(Direction::EAST), Direction::NORTH);
+    QCOMPARE(view.toMaze(0, 0), qMakePair(1, 0));
+    delete maze;
+}
+
+}
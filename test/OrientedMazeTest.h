@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QObject>
+
+namespace mms {
+
+// Checks that every orientation of a maze, and the fields computed over it,
+// match the maze rotated or mirrored one wall at a time
+class OrientedMazeTest : public QObject {
+
+    Q_OBJECT
+
+private slots:
+
+    void testOrientations_data();
+    void testOrientations();
+    void testClockwise();
+};
+
+}
@@ -0,0 +1,136 @@
+#include "TestUtilities.h"
+
+#include <QDir>
+#include <QFile>
+
+#include <random>
+
+#include "Direction.h"
+
+namespace mms {
+
+WallGrid TestUtilities::getRandomWalls(
+        int width, int height, bool enclosed, quint64 seed) {
+    std::mt19937_64 rng(seed);
+    WallGrid walls(width, height);
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            for (Direction direction : DIRECTIONS()) {
+                walls.setWall(x, y, direction, rng() & 1);
+            }
+        }
+    }
+    if (enclosed) {
+        for (int x = 0; x < width; x += 1) {
+            walls.setWall(x, 0, Direction::SOUTH, true);
+            walls.setWall(x, height - 1, Direction::NORTH, true);
+        }
+        for (int y = 0; y < height; y += 1) {
+            walls.setWall(0, y, Direction::WEST, true);
+            walls.setWall(width - 1, y, Direction::EAST, true);
+        }
+    }
+    return walls;
+}
+
+WallGrid TestUtilities::getTransformedWalls(
+        const WallGrid& walls, Symmetry symmetry) {
+
+    // Mirror each wall and then swap its axes, see Symmetry.h
+    bool mirrorX = SYMMETRY_MIRRORS_X().value(symmetry);
+    bool mirrorY = SYMMETRY_MIRRORS_Y().value(symmetry);
+    bool swapAxes = SYMMETRY_SWAPS_AXES().value(symmetry);
+    int width = walls.getWidth();
+    int height = walls.getHeight();
+    WallGrid transformed(swapAxes ? height : width, swapAxes ? width : height);
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            for (Direction direction : DIRECTIONS()) {
+                int tx = mirrorX ? width - 1 - x : x;
+                int ty = mirrorY ? height - 1 - y : y;
+                bool isEastWest =
+                    direction == Direction::EAST ||
+                    direction == Direction::WEST;
+                Direction td = direction;
+                if (isEastWest ? mirrorX : mirrorY) {
+                    td = DIRECTION_ROTATE_LEFT().value(
+                        DIRECTION_ROTATE_LEFT().value(td));
+                }
+                if (swapAxes) {
+                    qSwap(tx, ty);
+                    td = td == Direction::NORTH ? Direction::EAST :
+                         td == Direction::EAST ? Direction::NORTH :
+                         td == Direction::SOUTH ? Direction::WEST :
+                         Direction::SOUTH;
+                }
+                transformed.setWall(tx, ty, td, walls.isWall(x, y, direction));
+            }
+        }
+    }
+    return transformed;
+}
+
+QByteArray TestUtilities::toNumFile(const WallGrid& walls) {
+    QByteArray contents;
+    for (int x = 0; x < walls.getWidth(); x += 1) {
+        for (int y = 0; y < walls.getHeight(); y += 1) {
+            contents += QByteArray::number(x) + " " + QByteArray::number(y);
+            for (Direction direction : DIRECTIONS()) {
+                contents += walls.isWall(x, y, direction) ? " 1" : " 0";
+            }
+            contents += "\n";
+        }
+    }
+    return contents;
+}
+
+QByteArray TestUtilities::toMapFile(const WallGrid& walls) {
+
+    // From the top row down, the northern edge of each row and then its
+    // western and eastern walls; the southern edge of the maze comes last
+    int width = walls.getWidth();
+    int height = walls.getHeight();
+    QByteArray contents;
+    for (int y = height - 1; y >= 0; y -= 1) {
+        contents += "+";
+        for (int x = 0; x < width; x += 1) {
+            contents += walls.isWall(x, y, Direction::NORTH) ? "---+" : "   +";
+        }
+        contents += "\n";
+        for (int x = 0; x < width; x += 1) {
+            contents += walls.isWall(x, y, Direction::WEST) ? "|   " : "    ";
+        }
+        contents += walls.isWall(width - 1, y, Direction::EAST) ? "|" : " ";
+        contents += "\n";
+    }
+    contents += "+";
+    for (int x = 0; x < width; x += 1) {
+        contents += walls.isWall(x, 0, Direction::SOUTH) ? "---+" : "   +";
+    }
+    contents += "\n";
+    return contents;
+}
+
+QByteArray TestUtilities::toMazFile(const WallGrid& walls) {
+    QByteArray contents;
+    for (int x = 0; x < walls.getWidth(); x += 1) {
+        for (int y = 0; y < walls.getHeight(); y += 1) {
+            contents += static_cast<char>(walls.getWallMask(x, y));
+        }
+    }
+    return contents;
+}
+
+QString TestUtilities::writeFile(
+        const QString& directory,
+        const QString& name,
+        const QByteArray& contents) {
+    QString path = QDir(directory).filePath(name);
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly) || file.write(contents) != contents.size()) {
+        return QString();
+    }
+    return path;
+}
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+
+#include "Symmetry.h"
+#include "WallGrid.h"
+
+namespace mms {
+
+// Helpers shared by the tests. These are written as plainly as possible, one
+// wall at a time, so that they can serve as references for the optimized code.
+class TestUtilities {
+
+public:
+
+    TestUtilities() = delete;
+
+    // Each wall is set with probability one half; if enclosed, the walls
+    // around the edge of the maze are then all set
+    static WallGrid getRandomWalls(
+        int width, int height, bool enclosed, quint64 seed);
+
+    // The walls as rotated or mirrored by the symmetry
+    static WallGrid getTransformedWalls(
+        const WallGrid& walls, Symmetry symmetry);
+
+    // The walls in each of the maze file formats; maz files must be square
+    static QByteArray toNumFile(const WallGrid& walls);
+    static QByteArray toMapFile(const WallGrid& walls);
+    static QByteArray toMazFile(const WallGrid& walls);
+
+    // Writes the contents to a file in the directory, returns its path
+    static QString writeFile(
+        const QString& directory,
+        const QString& name,
+        const QByteArray& contents);
+};
+
+}
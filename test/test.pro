@@ -0,0 +1,61 @@
+QT += core
+QT += testlib
+QT -= gui
+
+TEMPLATE = app
+TARGET = tests
+
+CONFIG += c++11
+CONFIG += console
+CONFIG += testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += ../src
+
+HEADERS += FloodFillTest.h
+HEADERS += MazeCorpusTest.h
+HEADERS += MazeFileTest.h
+HEADERS += MazeGeneratorTest.h
+HEADERS += MazeGraphicTest.h
+HEADERS += MazeHashTest.h
+HEADERS += OrientedMazeTest.h
+HEADERS += TestUtilities.h
+
+SOURCES += FloodFillTest.cpp
+SOURCES += Main.cpp
+SOURCES += MazeCorpusTest.cpp
+SOURCES += MazeFileTest.cpp
+SOURCES += MazeGeneratorTest.cpp
+SOURCES += MazeGraphicTest.cpp
+SOURCES += MazeHashTest.cpp
+SOURCES += OrientedMazeTest.cpp
+SOURCES += TestUtilities.cpp
+SOURCES += ../src/BufferInterface.cpp
+SOURCES += ../src/Color.cpp
+SOURCES += ../src/ColorManager.cpp
+SOURCES += ../src/Dimensions.cpp
+SOURCES += ../src/Direction.cpp
+SOURCES += ../src/FieldEngine.cpp
+SOURCES += ../src/FloodFill.cpp
+SOURCES += ../src/FontImage.cpp
+SOURCES += ../src/GeometryUtilities.cpp
+SOURCES += ../src/Maze.cpp
+SOURCES += ../src/MazeCorpus.cpp
+SOURCES += ../src/MazeGenerator.cpp
+SOURCES += ../src/MazeGraphic.cpp
+SOURCES += ../src/MazeHash.cpp
+SOURCES += ../src/MazeView.cpp
+SOURCES += ../src/OrientedMaze.cpp
+SOURCES += ../src/Polygon.cpp
+SOURCES += ../src/Settings.cpp
+SOURCES += ../src/SimUtilities.cpp
+SOURCES += ../src/Symmetry.cpp
+SOURCES += ../src/TileGeometry.cpp
+SOURCES += ../src/TileGraphic.cpp
+SOURCES += ../src/TileGraphicTextCache.cpp
+SOURCES += ../src/WallGrid.cpp
+SOURCES += ../src/polypartition/polypartition.cpp
+
+DESTDIR     = ../bin
+MOC_DIR     = ../build/test/moc
+OBJECTS_DIR = ../build/test/obj